@@ -23,6 +23,7 @@
 #include <polyglotbook.h>
 #include <tournament.h>
 #include <gamemanager.h>
+#include <concurrencycontroller.h>
 #include <sprt.h>
 
 
@@ -100,6 +101,16 @@ void EngineMatch::setBookMode(OpeningBook::AccessMode mode)
 	m_bookMode = mode;
 }
 
+void EngineMatch::setConcurrencyController(ConcurrencyController* controller)
+{
+	Q_ASSERT(controller != nullptr);
+
+	connect(m_tournament, SIGNAL(gameFinished(ChessGame*, int, int, int)),
+		controller, SLOT(addGame(ChessGame*)));
+	connect(controller, SIGNAL(decisionMade(int, int, QString)),
+		this, SLOT(onConcurrencyDecision(int, int, QString)));
+}
+
 void EngineMatch::onGameStarted(ChessGame* game, int number)
 {
 	Q_ASSERT(game != nullptr);
@@ -150,12 +161,30 @@ void EngineMatch::onTournamentFinished()
 	if (!error.isEmpty())
 		qWarning("%s", qUtf8Printable(error));
 
-	qInfo("Finished match");
+	const double hours = m_startTime.elapsed() / 3600000.0;
+	const int games = m_tournament->finishedGameCount();
+	qInfo("Finished match: %d games in %.0f seconds (%.1f games per hour)",
+	      games, hours * 3600.0, hours > 0.0 ? games / hours : 0.0);
+	const CpuAffinity affinity = m_tournament->gameManager()->cpuAffinity();
+	if (affinity.isEnabled())
+		qInfo("CPU affinity: %s", qUtf8Printable(affinity.toString()));
 	connect(m_tournament->gameManager(), SIGNAL(finished()),
 		this, SIGNAL(finished()));
 	m_tournament->gameManager()->finish();
 }
 
+void EngineMatch::onConcurrencyDecision(int oldConcurrency,
+					int newConcurrency,
+					const QString& reason)
+{
+	if (newConcurrency == oldConcurrency)
+		qInfo("Concurrency stays at %d: %s",
+		      oldConcurrency, qUtf8Printable(reason));
+	else
+		qInfo("Concurrency changed from %d to %d: %s",
+		      oldConcurrency, newConcurrency, qUtf8Printable(reason));
+}
+
 void EngineMatch::print(const QString& msg)
 {
 	qInfo("%lld %s", m_startTime.elapsed(), qUtf8Printable(msg));
@@ -28,6 +28,7 @@
 class ChessGame;
 class OpeningBook;
 class Tournament;
+class ConcurrencyController;
 
 
 class EngineMatch : public QObject
@@ -42,6 +43,7 @@ class EngineMatch : public QObject
 		void setDebugMode(bool debug);
 		void setRatingInterval(int interval);
 		void setBookMode(OpeningBook::AccessMode mode);
+		void setConcurrencyController(ConcurrencyController* controller);
 
 		void start();
 		void stop();
@@ -53,6 +55,9 @@ class EngineMatch : public QObject
 		void onGameStarted(ChessGame* game, int number);
 		void onGameFinished(ChessGame* game, int number);
 		void onTournamentFinished();
+		void onConcurrencyDecision(int oldConcurrency,
+					   int newConcurrency,
+					   const QString& reason);
 		void print(const QString& msg);
 
 	private:
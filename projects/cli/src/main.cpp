@@ -25,18 +25,22 @@
 #include <QStringList>
 #include <QFile>
 #include <QMetaType>
+#include <QThread>
 
 #include <mersenne.h>
 #include <enginemanager.h>
 #include <enginebuilder.h>
 #include <gamemanager.h>
+#include <concurrencycontroller.h>
 #include <tournament.h>
 #include <tournamentfactory.h>
 #include <board/boardfactory.h>
+#include <board/gomokuboard.h>
 #include <enginefactory.h>
 #include <enginetextoption.h>
 #include <openingsuite.h>
 #include <sprt.h>
+#include <trace.h>
 #include <board/syzygytablebase.h>
 #include <board/result.h>
 
@@ -243,6 +247,9 @@ EngineMatch* parseMatch(const QStringList& args, QObject* parent)
 	parser.addOption("-each", QVariant::StringList, 1);
 	parser.addOption("-variant", QVariant::String, 1, 1);
 	parser.addOption("-concurrency", QVariant::Int, 1, 1);
+	parser.addOption("-workers", QVariant::Int, 1, 1);
+	parser.addOption("-autoconcurrency", QVariant::StringList);
+	parser.addOption("-affinity", QVariant::String, 1, 1);
 	parser.addOption("-draw", QVariant::StringList);
 	parser.addOption("-resign", QVariant::StringList);
 	parser.addOption("-maxmoves", QVariant::Int, 1, 1);
@@ -255,6 +262,7 @@ EngineMatch* parseMatch(const QStringList& args, QObject* parent)
 	parser.addOption("-sprt", QVariant::StringList);
 	parser.addOption("-ratinginterval", QVariant::Int, 1, 1);
 	parser.addOption("-debug", QVariant::Bool, 0, 0);
+	parser.addOption("-trace", QVariant::String, 1, 1);
 	parser.addOption("-openings", QVariant::StringList);
 	parser.addOption("-bookmode", QVariant::String);
 	parser.addOption("-pgnout", QVariant::StringList, 1, 3);
@@ -262,14 +270,19 @@ EngineMatch* parseMatch(const QStringList& args, QObject* parent)
 	parser.addOption("-repeat", QVariant::Int, 0, 1);
 	parser.addOption("-noswap", QVariant::Bool, 0, 0);
 	parser.addOption("-recover", QVariant::Bool, 0, 0);
+	parser.addOption("-pondering", QVariant::String, 1, 1);
+	parser.addOption("-openingrule", QVariant::String, 1, 1);
 	parser.addOption("-site", QVariant::String, 1, 1);
 	parser.addOption("-wait", QVariant::Int, 1, 1);
+	parser.addOption("-lookahead", QVariant::Int, 1, 1);
 	parser.addOption("-seeds", QVariant::UInt, 1, 1);
-	parser.addOption("-boardsize", QVariant::Int, 1, 1);
+	parser.addOption("-boardsize", QVariant::String, 1, 1);
 	if (!parser.parse())
 		return nullptr;
 
 	GameManager* manager = CuteChessCoreApplication::instance()->gameManager();
+	// Share one thread per core between the games
+	manager->setWorkerCount(qMax(QThread::idealThreadCount(), 1));
 
 	QString ttype = parser.takeOption("-tournament").toString();
 	if (ttype.isEmpty())
@@ -285,7 +298,9 @@ EngineMatch* parseMatch(const QStringList& args, QObject* parent)
 
 	QList<EngineData> engines;
 	QStringList eachOptions;
+	QString pondering;
 	GameAdjudicator adjudicator;
+	ConcurrencyController* controller = nullptr;
 
 	const auto options = parser.options();
 	for (const auto& option : options)
@@ -320,6 +335,49 @@ EngineMatch* parseMatch(const QStringList& args, QObject* parent)
 			if (ok)
 				manager->setConcurrency(value.toInt());
 		}
+		// Bounds for adjusting the concurrency during the match
+		else if (name == "-autoconcurrency")
+		{
+			QMap<QString, QString> params =
+				option.toMap("min|max|games=0");
+			bool minOk = false;
+			bool maxOk = false;
+			bool gamesOk = false;
+			int minimum = params["min"].toInt(&minOk);
+			int maximum = params["max"].toInt(&maxOk);
+			int games = params["games"].toInt(&gamesOk);
+
+			ok = (minOk && maxOk && gamesOk
+			      && minimum > 0 && maximum >= minimum && games >= 0);
+			if (ok)
+			{
+				delete controller;
+				controller = new ConcurrencyController(manager, match);
+				controller->setRange(minimum, maximum);
+				controller->setInterval(games);
+			}
+		}
+		// Size of the worker thread pool
+		else if (name == "-workers")
+		{
+			ok = value.toInt() >= 0;
+			if (ok)
+				manager->setWorkerCount(value.toInt());
+		}
+		// CPU affinity policy of the engine processes
+		else if (name == "-affinity")
+		{
+			CpuAffinity affinity;
+			if (!CpuAffinity::isSupported())
+			{
+				qWarning("CPU affinity is not supported on this platform");
+				ok = false;
+			}
+			else
+				ok = affinity.parse(value.toString());
+			if (ok)
+				manager->setCpuAffinity(affinity);
+		}
 		// Threshold for draw adjudication
 		else if (name == "-draw")
 		{
@@ -430,6 +488,9 @@ EngineMatch* parseMatch(const QStringList& args, QObject* parent)
 			QLoggingCategory::defaultCategory()->setEnabled(QtDebugMsg, true);
 			match->setDebugMode(true);
 		}
+		// Trace output of the library's internals
+		else if (name == "-trace")
+			ok = Trace::setFilter(value.toString());
 		// Use an opening suite
 		else if (name == "-openings")
 		{
@@ -560,6 +621,23 @@ EngineMatch* parseMatch(const QStringList& args, QObject* parent)
 		// Recover crashed/stalled engines
 		else if (name == "-recover")
 			tournament->setRecoveryMode(true);
+		// Pondering for all engines
+		else if (name == "-pondering")
+		{
+			pondering = value.toString();
+			ok = (pondering == "on" || pondering == "off");
+		}
+		// Swap opening rule
+		else if (name == "-openingrule")
+		{
+			const QString rule = value.toString();
+			if (rule == "swap1")
+				tournament->setSwapOpening(ChessGame::Swap1);
+			else if (rule == "swap2")
+				tournament->setSwapOpening(ChessGame::Swap2);
+			else
+				ok = false;
+		}
 		// Site/location name
 		else if (name == "-site")
 			tournament->setSite(value.toString());
@@ -577,6 +655,13 @@ EngineMatch* parseMatch(const QStringList& args, QObject* parent)
 			if (ok)
 				tournament->setStartDelay(value.toInt());
 		}
+		// Number of games to prepare ahead of time
+		else if (name == "-lookahead")
+		{
+			ok = value.toInt() >= 0;
+			if (ok)
+				tournament->setLookahead(value.toInt());
+		}
 		// How many players should be seeded?
 		else if (name == "-seeds")
 		{
@@ -585,14 +670,23 @@ EngineMatch* parseMatch(const QStringList& args, QObject* parent)
 				tournament->setSeedCount(seedCount);
 		}
 		// Setup gomoku board size
+		// Board size (gomoku only): N for NxN squares, or WxH
 		else if (name == "-boardsize")
 		{
-			int newSize = value.toInt();
-			if (newSize > 4 && newSize < 32) {
-				tournament->setBoardSize(newSize);
-			} else {
-				qWarning("Board size is ignored since it is out of range: %d", newSize);
-			}
+			const QStringList list = value.toString().split('x');
+			bool widthOk = false;
+			bool heightOk = list.size() == 1;
+			int width = list.first().toInt(&widthOk);
+			int height = width;
+			if (list.size() == 2)
+				height = list.last().toInt(&heightOk);
+
+			if (widthOk && heightOk && width > 4 && height > 4
+			&&  Chess::GomokuBoard::isValidSize(width, height))
+				tournament->setBoardSize(width, height);
+			else
+				qWarning("Board size is ignored since it is out of range: %s",
+					 qUtf8Printable(value.toString()));
 		}
 		else
 			qFatal("Unknown argument: \"%s\"", qUtf8Printable(name));
@@ -633,6 +727,14 @@ EngineMatch* parseMatch(const QStringList& args, QObject* parent)
 		}
 	}
 
+	// Overrides the engines' own ponder settings, so that the same
+	// match can be played with and without pondering
+	if (!pondering.isEmpty())
+	{
+		for (auto& engine : engines)
+			engine.config.setPondering(pondering == "on");
+	}
+
 	const auto& constEngines = engines;
 	for (const auto& engine : constEngines)
 	{
@@ -678,6 +780,13 @@ EngineMatch* parseMatch(const QStringList& args, QObject* parent)
 
 	tournament->setAdjudicator(adjudicator);
 
+	if (controller != nullptr)
+	{
+		// Apply the range again in case -concurrency came later
+		controller->setRange(controller->minimum(), controller->maximum());
+		match->setConcurrencyController(controller);
+	}
+
 	return match;
 }
 
@@ -23,6 +23,7 @@
 #include <QPropertyAnimation>
 #include <QImage>
 #include <board/square.h>
+#include <board/gomokuboard.h>
 #include "graphicspiece.h"
 
 namespace {
@@ -99,7 +100,7 @@ void GraphicsBoard::paint(QPainter* painter,
 			  	const QStyleOptionGraphicsItem* option,
 			  	QWidget* widget)
 {
-	if (m_variant == "gomoku") {
+	if (Chess::GomokuBoard::isGomokuVariant(m_variant)) {
 		paintGomoku(painter, option, widget);
 	} else {
 		paintChess(painter, option, widget);
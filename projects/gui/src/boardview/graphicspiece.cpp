@@ -21,6 +21,7 @@
 #include <QPainter>
 
 #include <cctype>
+#include <board/gomokuboard.h>
 
 GraphicsPiece::GraphicsPiece(const Chess::Piece& piece,
 			     qreal squareSize,
@@ -55,7 +56,7 @@ void GraphicsPiece::paint(QPainter* painter,
 			  	const QStyleOptionGraphicsItem* option,
 			  	QWidget* widget)
 {
-	if (m_variant == "gomoku") {
+	if (Chess::GomokuBoard::isGomokuVariant(m_variant)) {
 		paintGomoku(painter, option, widget);
 	} else {
 		paintChess(painter, option, widget);
@@ -149,8 +149,8 @@ void GameViewer::setGame(ChessGame* game)
 	// the board (otherwise its size will remain no change, because pgn game
 	// does not contain board size, so it will miss this info, and re-construct
 	// the board with the default size).
-	int boardSize = game->board()->width();
-	game->pgn()->setBoardSize(boardSize);
+	game->pgn()->setBoardSize(game->board()->width(),
+				  game->board()->height());
 	
 	setGame(game->pgn());
 
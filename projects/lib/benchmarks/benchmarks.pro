@@ -1,2 +1,2 @@
 TEMPLATE = subdirs
-SUBDIRS = pgngame
+SUBDIRS = pgngame gomokuboard enginewrite
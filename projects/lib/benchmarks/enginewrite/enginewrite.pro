@@ -0,0 +1,4 @@
+include(../benchmarks.pri)
+
+TARGET = tst_enginewrite
+SOURCES += tst_enginewrite.cpp
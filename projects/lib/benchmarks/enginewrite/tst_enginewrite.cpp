@@ -0,0 +1,121 @@
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include <gomocupengine.h>
+#include <gamemanager.h>
+
+
+/*!
+ * A device that throws away everything written to it, and counts
+ * the writes that would have been system calls on a real pipe.
+ */
+class NullDevice : public QIODevice
+{
+	public:
+		NullDevice()
+			: m_writeCount(0)
+		{
+			open(QIODevice::ReadWrite);
+		}
+
+		int writeCount() const
+		{
+			return m_writeCount;
+		}
+
+	protected:
+		qint64 readData(char* data, qint64 maxSize)
+		{
+			Q_UNUSED(data);
+			Q_UNUSED(maxSize);
+			return 0;
+		}
+
+		qint64 writeData(const char* data, qint64 size)
+		{
+			Q_UNUSED(data);
+			m_writeCount++;
+			return size;
+		}
+
+	private:
+		int m_writeCount;
+};
+
+class tst_EngineWrite: public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void write_data() const;
+		void write();
+};
+
+void tst_EngineWrite::write_data() const
+{
+	QTest::addColumn<int>("batchSize");
+	QTest::addColumn<bool>("debug");
+
+	// A batch of 225 lines is a full 15x15 BOARD command
+	const int sizes[] = { 1, 16, 225 };
+	for (int size : sizes)
+	{
+		QTest::newRow(qPrintable(QString("%1 lines per write").arg(size)))
+			<< size << false;
+		QTest::newRow(qPrintable(QString("%1 lines per write, debug").arg(size)))
+			<< size << true;
+	}
+}
+
+void tst_EngineWrite::write()
+{
+	QFETCH(int, batchSize);
+	QFETCH(bool, debug);
+
+	const int lineCount = 900;
+	QStringList lines;
+	for (int i = 0; i < lineCount; i++)
+		lines << QString("%1,%2,%3").arg(i % 15).arg(i / 15 % 15).arg(i % 2 + 1);
+
+	GomocupEngine engine;
+	NullDevice* device = new NullDevice;
+	engine.setDevice(device);
+	engine.start();
+
+	// Wire the engine like GameManager does: with a debug log the
+	// engine is connected to the manager, which forwards the
+	// messages, and without one the engine is left unconnected
+	GameManager manager;
+	int debugCount = 0;
+	if (debug)
+	{
+		connect(&manager, &GameManager::debugMessage,
+			[&](const QString&) { debugCount++; });
+		connect(&engine, SIGNAL(debugMessage(QString)),
+			&manager, SIGNAL(debugMessage(QString)));
+	}
+
+	qint64 written = 0;
+	QElapsedTimer timer;
+	timer.start();
+
+	QBENCHMARK
+	{
+		for (int i = 0; i < lineCount; i += batchSize)
+		{
+			engine.beginWriteBatch();
+			const int end = qMin(i + batchSize, lineCount);
+			for (int j = i; j < end; j++)
+				engine.write(lines.at(j), ChessEngine::Unbuffered);
+			engine.endWriteBatch();
+		}
+		written += lineCount;
+	}
+
+	const qint64 ms = qMax<qint64>(timer.elapsed(), 1);
+	qDebug("%lld lines/s, %d device writes",
+	       written * 1000 / ms, device->writeCount());
+	QVERIFY(!debug || debugCount > 0);
+}
+
+QTEST_MAIN(tst_EngineWrite)
+#include "tst_enginewrite.moc"
@@ -0,0 +1,4 @@
+include(../benchmarks.pri)
+
+TARGET = tst_gomokuboard
+SOURCES += tst_gomokuboard.cpp
@@ -0,0 +1,167 @@
+#include <QtTest/QtTest>
+#include <board/gomokuboard.h>
+#include <board/gomokupatterns.h>
+
+
+class BenchmarkBoard : public Chess::GomokuBoard
+{
+	public:
+		using Chess::GomokuBoard::findFiveConnections;
+
+		/*!
+		 * The per-square scan that findFiveConnections() did
+		 * before it used the pattern kernel.
+		 */
+		int scalarFiveCount()
+		{
+			static const int offsets[4][2] = {
+				{ 1, 0 }, { 0, 1 }, { 1, 1 }, { 1, -1 }
+			};
+			int count = 0;
+
+			for (int d = 0; d < 4; d++)
+			{
+				int fo = offsets[d][0];
+				int ro = offsets[d][1];
+				int fileEnd = (fo == 1) ? width() - 4 : width();
+				int rankStart = (ro == -1) ? 4 : 0;
+				int rankEnd = (ro == 1) ? height() - 4 : height();
+
+				for (int i = 0; i < fileEnd; i++)
+				{
+					for (int j = rankStart; j < rankEnd; j++)
+					{
+						Chess::Square sq(i, j);
+						if (pieceAt(sq) != Chess::Piece::NoPiece
+						&&  checkFiveConnection(sq, fo, ro))
+							count++;
+					}
+				}
+			}
+
+			return count;
+		}
+
+		const Chess::GomokuBitboard& bitboard() const
+		{
+			return m_bitboard;
+		}
+};
+
+class tst_GomokuBoard: public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void fiveConnections_data() const;
+		void fiveConnections();
+		void patternKernel_data() const;
+		void patternKernel();
+
+	private:
+		void fillBoard(BenchmarkBoard* board, int size);
+		void addSizes() const;
+};
+
+void tst_GomokuBoard::addSizes() const
+{
+	QTest::addColumn<int>("size");
+	QTest::addColumn<bool>("kernel");
+
+	const int sizes[] = { 15, 20, 31, 40, 64 };
+	for (int size : sizes)
+	{
+		QTest::newRow(qPrintable(QString("%1x%1 scalar").arg(size)))
+			<< size << false;
+		QTest::newRow(qPrintable(QString("%1x%1 %2").arg(size)
+			.arg(Chess::GomokuPatterns::instructionSet())))
+			<< size << true;
+	}
+}
+
+void tst_GomokuBoard::fillBoard(BenchmarkBoard* board, int size)
+{
+	board->setSize(size);
+
+	// Fill about 40% of the board with a fixed, irregular pattern
+	QVector<Chess::Move> moves = board->legalMoves();
+	for (int i = 0; i < moves.size(); i++)
+	{
+		if ((i * 7919) % 5 < 2)
+			board->makeMove(moves.at(i));
+	}
+}
+
+void tst_GomokuBoard::fiveConnections_data() const
+{
+	addSizes();
+}
+
+void tst_GomokuBoard::fiveConnections()
+{
+	QFETCH(int, size);
+	QFETCH(bool, kernel);
+
+	BenchmarkBoard board;
+	fillBoard(&board, size);
+	QCOMPARE(board.findFiveConnections().size(), board.scalarFiveCount());
+
+	int count = 0;
+	if (kernel)
+	{
+		QBENCHMARK
+		{
+			count += board.findFiveConnections().size();
+		}
+	}
+	else
+	{
+		QBENCHMARK
+		{
+			count += board.scalarFiveCount();
+		}
+	}
+	QVERIFY(count >= 0);
+}
+
+void tst_GomokuBoard::patternKernel_data() const
+{
+	addSizes();
+}
+
+void tst_GomokuBoard::patternKernel()
+{
+	QFETCH(int, size);
+	QFETCH(bool, kernel);
+
+	BenchmarkBoard board;
+	fillBoard(&board, size);
+
+	using namespace Chess;
+	const GomokuBitboard& bb = board.bitboard();
+	const int stride = bb.lineStride();
+	QVector<quint32> matches(GomokuPatterns::PatternCount * stride);
+	quint32* const out[GomokuPatterns::PatternCount] = {
+		matches.data(), matches.data() + stride,
+		matches.data() + 2 * stride, matches.data() + 3 * stride,
+		matches.data() + 4 * stride
+	};
+	auto classify = kernel ? GomokuPatterns::classify
+			       : GomokuPatterns::classifyScalar;
+
+	QBENCHMARK
+	{
+		for (int dir = 0; dir < GomokuBitboard::DirectionCount; dir++)
+		{
+			auto d = GomokuBitboard::Direction(dir);
+			classify(bb.lines(Side::Black, d),
+				 bb.lines(Side::White, d),
+				 bb.lineMasks(d),
+				 bb.lineCount(d),
+				 out);
+		}
+	}
+}
+
+QTEST_MAIN(tst_GomokuBoard)
+#include "tst_gomokuboard.moc"
@@ -20,8 +20,6 @@
 #include <QStringList>
 #include "zobrist.h"
 
-#include <iostream>
-
 
 namespace Chess {
 
@@ -685,8 +683,6 @@ void Board::makeMove(const Move& move, BoardTransition* transition)
 	xorKey(m_zobrist->side());
 	m_side = m_side.opposite();
 	m_moveHistory << md;
-
-	std::cout << "call Board::makeMove" << std::endl;
 }
 
 void Board::undoMove()
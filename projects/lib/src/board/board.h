@@ -306,6 +306,10 @@ class LIB_EXPORT Board
 
 		virtual void setSize(int sz) = 0;
 
+		/*!
+		 * Returns the moves played since the starting position,
+		 * the first move first.
+		 */
 		virtual QVector<Move> getHistoricalMoves() = 0;
 
 	protected:
@@ -63,6 +63,11 @@ SOURCES += $$PWD/board.cpp \
     $$PWD/boardtransition.cpp \
     $$PWD/syzygytablebase.cpp \
     $$PWD/gomokuboard.cpp \
+    $$PWD/gomokuzobrist.cpp \
+    $$PWD/gomokubitboard.cpp \
+    $$PWD/gomokupatterns.cpp \
+    $$PWD/gomokusquareset.cpp \
+    $$PWD/renjuboard.cpp \
     $$PWD/chessboard.cpp
 HEADERS += $$PWD/board.h \
     $$PWD/move.h \
@@ -130,4 +135,11 @@ HEADERS += $$PWD/board.h \
     $$PWD/boardtransition.h \
     $$PWD/syzygytablebase.h \
     $$PWD/gomokuboard.h \
+    $$PWD/gomokuzobrist.h \
+    $$PWD/gomokubitboard.h \
+    $$PWD/gomokupatterns.h \
+    $$PWD/gomokusquareset.h \
+    $$PWD/gomokuposition.h \
+    $$PWD/gomokuruleboard.h \
+    $$PWD/renjuboard.h \
     $$PWD/chessboard.h
\ No newline at end of file
@@ -70,6 +70,8 @@
 #include "twokingseachboard.h"
 
 #include "gomokuboard.h"
+#include "gomokuruleboard.h"
+#include "renjuboard.h"
 
 namespace Chess {
 
@@ -140,6 +142,9 @@ REGISTER_BOARD(TwoKingsEachBoard, "twokings")
 REGISTER_BOARD(TwoKingsSymmetricalBoard, "twokingssymmetric")
 
 REGISTER_BOARD(GomokuBoard, "gomoku")
+REGISTER_BOARD(StandardGomokuBoard, "gomoku-standard")
+REGISTER_BOARD(CaroBoard, "caro")
+REGISTER_BOARD(RenjuBoard, "renju")
 
 
 ClassRegistry<Board>* BoardFactory::registry()
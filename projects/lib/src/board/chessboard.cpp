@@ -19,8 +19,7 @@
 #include "chessboard.h"
 #include <QStringList>
 #include "zobrist.h"
-
-#include <iostream>
+#include "trace.h"
 
 
 namespace Chess {
@@ -702,7 +701,8 @@ void ChessBoard::makeMove(const Move& move, BoardTransition* transition)
 	m_side = m_side.opposite();
 	m_moveHistory << md;
 
-	std::cout << "call ChessBoard::makeMove" << std::endl;
+	ccTraceVerbose(lcBoard).noquote() << variant() << "ply"
+		<< m_moveHistory.size() << "key" << QString::number(m_key, 16);
 }
 
 void ChessBoard::undoMove()
@@ -981,12 +981,12 @@ bool ChessBoard::pieceHasMovement(int pieceType, unsigned movement) const
 }
 
 void ChessBoard::setWidth(int wd) {
-	Q_ASSERT(wd > 0 && wd < 32);
+	Q_ASSERT(wd > 0);
 	//m_width = wd; // we do not allow to change the board size
 }
 
 void ChessBoard::setHeight(int ht) {
-	Q_ASSERT(ht > 0 && ht < 32);
+	Q_ASSERT(ht > 0);
 	//m_height = ht; // we do not allow to change the board size
 }
 
@@ -998,8 +998,9 @@ void ChessBoard::setSize(int sz) {
 QVector<Move> ChessBoard::getHistoricalMoves()
 {
 	QVector<Move> histMoves;
-	for (int i = m_moveHistory.size() - 1; i >= 0; i--) {
-		histMoves << m_moveHistory[i].move;
+	histMoves.reserve(m_moveHistory.size());
+	for (const MoveData& md : m_moveHistory) {
+		histMoves << md.move;
 	}
 	return histMoves;
 }
@@ -0,0 +1,210 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gomokubitboard.h"
+#include <cstring>
+#include "gomokupatterns.h"
+
+namespace {
+
+// Steps along the lines of each GomokuBitboard::Direction
+const int s_steps[Chess::GomokuBitboard::DirectionCount][2] = {
+	{ 1, 0 }, { 0, 1 }, { 1, 1 }, { 1, -1 }
+};
+
+} // anonymous namespace
+
+namespace Chess {
+
+GomokuBitboard::GomokuBitboard()
+{
+	clear(15, 15);
+}
+
+int GomokuBitboard::wordCount(int length)
+{
+	if (length <= LineBits)
+		return 1;
+	return 1 + (length - LineBits + WordStep - 1) / WordStep;
+}
+
+void GomokuBitboard::clear(int width, int height)
+{
+	Q_ASSERT(width > 0 && height > 0);
+
+	m_width = width;
+	m_height = height;
+
+	m_lineWords[Horizontal] = wordCount(width);
+	m_lineWords[Vertical] = wordCount(height);
+	m_lineWords[Diagonal] = wordCount(width);
+	m_lineWords[AntiDiagonal] = wordCount(width);
+
+	int maxCount = 0;
+	for (int dir = 0; dir < DirectionCount; dir++)
+		maxCount = qMax(maxCount, lineCount(Direction(dir)));
+
+	const int block = GomokuPatterns::BlockSize;
+	m_stride = (maxCount + block - 1) / block * block;
+
+	m_data.resize(ArrayCount * DirectionCount * m_stride);
+	std::memset(m_data.data(), 0, m_data.size() * sizeof(quint32));
+
+	for (int rank = 0; rank < height; rank++)
+	{
+		for (int file = 0; file < width; file++)
+		{
+			setBit(Masks, file, rank, true);
+
+			for (int dir = 0; dir < DirectionCount; dir++)
+			{
+				Direction d = Direction(dir);
+				array(OwnedMasks, d)[lineIndex(d, file, rank)] |=
+					1u << lineBit(d, file, rank);
+			}
+		}
+	}
+}
+
+void GomokuBitboard::setBit(Array array, int file, int rank, bool value)
+{
+	for (int dir = 0; dir < DirectionCount; dir++)
+	{
+		Direction d = Direction(dir);
+		quint32* words = this->array(array, d)
+			+ boardLineIndex(d, file, rank) * m_lineWords[d];
+
+		// Every word that covers the square
+		const int pos = linePosition(d, file, rank);
+		const int first = qMax(0, pos - LineBits + WordStep) / WordStep;
+		const int last = qMin(m_lineWords[d] - 1, pos / WordStep);
+		for (int word = first; word <= last; word++)
+		{
+			const quint32 bit = 1u << (pos - word * WordStep);
+			if (value)
+				words[word] |= bit;
+			else
+				words[word] &= ~bit;
+		}
+	}
+}
+
+void GomokuBitboard::setStone(Side side, int file, int rank)
+{
+	Q_ASSERT(!side.isNull());
+	Q_ASSERT(file >= 0 && file < m_width);
+	Q_ASSERT(rank >= 0 && rank < m_height);
+
+	setBit(side == Side::White ? WhiteLines : BlackLines, file, rank, true);
+}
+
+void GomokuBitboard::clearStone(Side side, int file, int rank)
+{
+	Q_ASSERT(!side.isNull());
+	Q_ASSERT(file >= 0 && file < m_width);
+	Q_ASSERT(rank >= 0 && rank < m_height);
+
+	setBit(side == Side::White ? WhiteLines : BlackLines, file, rank, false);
+}
+
+int GomokuBitboard::lineCount(Direction dir) const
+{
+	switch (dir)
+	{
+	case Horizontal:
+		return m_height * m_lineWords[dir];
+	case Vertical:
+		return m_width * m_lineWords[dir];
+	default:
+		return (m_width + m_height - 1) * m_lineWords[dir];
+	}
+}
+
+int GomokuBitboard::stoneCount(Side side) const
+{
+	const quint32* words = lines(side, Horizontal);
+	const quint32* owned = ownedMasks(Horizontal);
+
+	int count = 0;
+	for (int i = 0; i < lineCount(Horizontal); i++)
+		count += popCount(words[i] & owned[i]);
+	return count;
+}
+
+int GomokuBitboard::emptyCount() const
+{
+	const quint32* owned = ownedMasks(Horizontal);
+
+	int count = 0;
+	for (int i = 0; i < lineCount(Horizontal); i++)
+		count += popCount(emptyLine(Horizontal, i) & owned[i]);
+	return count;
+}
+
+int GomokuBitboard::connectionLength(Side side,
+				     Direction dir,
+				     int file,
+				     int rank) const
+{
+	if (!hasStone(side, file, rank))
+		return 0;
+
+	int length = 1;
+	for (int sign = -1; sign <= 1; sign += 2)
+	{
+		const int df = sign * s_steps[dir][0];
+		const int dr = sign * s_steps[dir][1];
+		int f = file + df;
+		int r = rank + dr;
+		while (f >= 0 && f < m_width && r >= 0 && r < m_height
+		&&     hasStone(side, f, r))
+		{
+			length++;
+			f += df;
+			r += dr;
+		}
+	}
+
+	return length;
+}
+
+bool GomokuBitboard::isPartOfFive(Side side, int file, int rank) const
+{
+	for (int dir = 0; dir < DirectionCount; dir++)
+	{
+		Direction d = Direction(dir);
+
+		// Use the word in which the square has at least four
+		// bits on both sides, unless the board line ends sooner
+		const int pos = linePosition(d, file, rank);
+		const int word = qMin(m_lineWords[d] - 1, qMax(0, pos - 4) / WordStep);
+		const int index = boardLineIndex(d, file, rank) * m_lineWords[d] + word;
+		const int bit = pos - word * WordStep;
+
+		// A five through 'bit' has to start on one of the bits
+		// bit - 4 ... bit
+		quint32 window = ((2u << bit) - 1) & ~((1u << qMax(0, bit - 4)) - 1);
+		quint32 starts = runStarts(line(side, d, index), 5);
+		if (starts & window)
+			return true;
+	}
+
+	return false;
+}
+
+} // namespace Chess
@@ -0,0 +1,350 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GOMOKUBITBOARD_H
+#define GOMOKUBITBOARD_H
+
+#include <QtGlobal>
+#include <QtAlgorithms>
+#include <QVarLengthArray>
+#include "side.h"
+
+namespace Chess {
+
+/*!
+ * \brief Per-side bitboards for gomoku boards of any size
+ *
+ * Every line of the board is stored as 32-bit words per side: the
+ * rows, the columns (the transposed board) and both diagonal
+ * directions (the rotated boards). A stone is kept in all four
+ * representations, so any line through a square can be examined with
+ * a few shifts and ANDs.
+ *
+ * Bit \a n of a row or diagonal corresponds to file \a n, and bit \a n
+ * of a column corresponds to rank \a n. Shifting a word by one bit
+ * therefore always moves one step along the line.
+ *
+ * Lines longer than LineBits squares are split into several words
+ * that start WordStep squares apart. Consecutive words overlap, so a
+ * pattern of up to LineBits - WordStep squares always fits entirely
+ * in one word. Each square is \e owned by exactly one word per
+ * direction (see ownedMask()), which lets callers report a match only
+ * once. On boards of up to 32x32 squares every line is a single word.
+ *
+ * The storage is allocated for the actual board size; boards of up
+ * to 20x20 squares don't need any heap memory.
+ *
+ * In this class "line" refers to a word, and board line to the whole
+ * row, column or diagonal.
+ */
+class LIB_EXPORT GomokuBitboard
+{
+	public:
+		/*! The four line directions of the board. */
+		enum Direction
+		{
+			Horizontal,	//!< Rows, from file 0 to the last file
+			Vertical,	//!< Columns, from rank 0 to the last rank
+			Diagonal,	//!< Lines going up and to the right
+			AntiDiagonal,	//!< Lines going down and to the right
+			DirectionCount
+		};
+
+		/*! The number of squares in one line word. */
+		static const int LineBits = 32;
+		/*! The distance between the first squares of two words. */
+		static const int WordStep = 24;
+
+		/*! Creates a new empty 15x15 bitboard. */
+		GomokuBitboard();
+
+		/*! Clears the board and resizes it to \a width x \a height. */
+		void clear(int width, int height);
+
+		/*! Returns the width of the board. */
+		int width() const;
+		/*! Returns the height of the board. */
+		int height() const;
+
+		/*! Returns the side of the stone on (\a file, \a rank). */
+		Side sideAt(int file, int rank) const;
+		/*! Returns true if \a side has a stone on (\a file, \a rank). */
+		bool hasStone(Side side, int file, int rank) const;
+		/*! Puts a stone of \a side on (\a file, \a rank). */
+		void setStone(Side side, int file, int rank);
+		/*! Removes the stone of \a side from (\a file, \a rank). */
+		void clearStone(Side side, int file, int rank);
+
+		/*! Returns the number of lines in direction \a dir. */
+		int lineCount(Direction dir) const;
+		/*!
+		 * Returns the size of the line arrays returned by lines(),
+		 * lineMasks() and ownedMasks(). It is at least lineCount()
+		 * of every direction, rounded up to a multiple of
+		 * GomokuPatterns::BlockSize.
+		 */
+		int lineStride() const;
+		/*!
+		 * Returns the index of the line in direction \a dir that
+		 * owns (\a file, \a rank).
+		 */
+		int lineIndex(Direction dir, int file, int rank) const;
+		/*!
+		 * Returns the bit that represents (\a file, \a rank) in the
+		 * line lineIndex(\a dir, \a file, \a rank).
+		 */
+		int lineBit(Direction dir, int file, int rank) const;
+		/*!
+		 * Returns the board line of line \a index in \a dir: the
+		 * rank of a row, the file of a column, or the diagonal's
+		 * number.
+		 */
+		int boardLine(Direction dir, int index) const;
+		/*!
+		 * Returns the position on its board line of bit 0 of line
+		 * \a index in \a dir.
+		 */
+		int lineOffset(Direction dir, int index) const;
+		/*! Returns the stones of \a side on line \a index in \a dir. */
+		quint32 line(Side side, Direction dir, int index) const;
+		/*! Returns the squares of line \a index in \a dir. */
+		quint32 lineMask(Direction dir, int index) const;
+		/*! Returns the squares owned by line \a index in \a dir. */
+		quint32 ownedMask(Direction dir, int index) const;
+		/*! Returns the empty squares of line \a index in \a dir. */
+		quint32 emptyLine(Direction dir, int index) const;
+		/*!
+		 * Returns the lines of \a side in direction \a dir as an
+		 * array of lineStride() elements.
+		 */
+		const quint32* lines(Side side, Direction dir) const;
+		/*!
+		 * Returns the masks of the lines in direction \a dir as an
+		 * array of lineStride() elements.
+		 */
+		const quint32* lineMasks(Direction dir) const;
+		/*!
+		 * Returns the owned squares of the lines in direction
+		 * \a dir as an array of lineStride() elements.
+		 */
+		const quint32* ownedMasks(Direction dir) const;
+
+		/*! Returns the number of stones of \a side on the board. */
+		int stoneCount(Side side) const;
+		/*! Returns the number of empty squares on the board. */
+		int emptyCount() const;
+
+		/*!
+		 * Returns the number of consecutive stones of \a side in
+		 * direction \a dir going through (\a file, \a rank).
+		 */
+		int connectionLength(Side side,
+				     Direction dir,
+				     int file,
+				     int rank) const;
+		/*!
+		 * Returns true if (\a file, \a rank) is part of a connection
+		 * of at least five stones of \a side.
+		 */
+		bool isPartOfFive(Side side, int file, int rank) const;
+
+		/*!
+		 * Returns a mask of the starting bits of every run of
+		 * \a length consecutive bits in \a bits.
+		 */
+		static quint32 runStarts(quint32 bits, int length);
+		/*! Returns the number of set bits in \a bits. */
+		static int popCount(quint32 bits);
+		/*! Returns the index of the lowest set bit in \a bits. */
+		static int lowestBit(quint32 bits);
+
+	private:
+		// Arrays of lineStride() words per direction in m_data
+		enum Array
+		{
+			WhiteLines,
+			BlackLines,
+			Masks,
+			OwnedMasks,
+			ArrayCount
+		};
+
+		static int wordCount(int length);
+		int boardLineIndex(Direction dir, int file, int rank) const;
+		static int linePosition(Direction dir, int file, int rank);
+		int ownerWord(Direction dir, int position) const;
+		quint32* array(Array array, Direction dir);
+		const quint32* array(Array array, Direction dir) const;
+		void setBit(Array array, int file, int rank, bool value);
+
+		int m_width;
+		int m_height;
+		int m_stride;
+		int m_lineWords[DirectionCount];
+		QVarLengthArray<quint32, ArrayCount * DirectionCount * 40> m_data;
+};
+
+inline int GomokuBitboard::width() const
+{
+	return m_width;
+}
+
+inline int GomokuBitboard::height() const
+{
+	return m_height;
+}
+
+inline int GomokuBitboard::lineStride() const
+{
+	return m_stride;
+}
+
+inline int GomokuBitboard::boardLineIndex(Direction dir, int file, int rank) const
+{
+	switch (dir)
+	{
+	case Horizontal:
+		return rank;
+	case Vertical:
+		return file;
+	case Diagonal:
+		return file - rank + m_height - 1;
+	default:
+		return file + rank;
+	}
+}
+
+inline int GomokuBitboard::linePosition(Direction dir, int file, int rank)
+{
+	return (dir == Vertical) ? rank : file;
+}
+
+inline int GomokuBitboard::ownerWord(Direction dir, int position) const
+{
+	// Word 0 owns positions 0 ... WordStep, the other words own
+	// their bits 1 ... WordStep, and the last word everything
+	// after that. This keeps the bits next to an owned pattern in
+	// the same word.
+	return qMin(m_lineWords[dir] - 1, qMax(0, position - 1) / WordStep);
+}
+
+inline int GomokuBitboard::lineIndex(Direction dir, int file, int rank) const
+{
+	return boardLineIndex(dir, file, rank) * m_lineWords[dir]
+		+ ownerWord(dir, linePosition(dir, file, rank));
+}
+
+inline int GomokuBitboard::lineBit(Direction dir, int file, int rank) const
+{
+	const int pos = linePosition(dir, file, rank);
+	return pos - ownerWord(dir, pos) * WordStep;
+}
+
+inline int GomokuBitboard::boardLine(Direction dir, int index) const
+{
+	return index / m_lineWords[dir];
+}
+
+inline int GomokuBitboard::lineOffset(Direction dir, int index) const
+{
+	return (index % m_lineWords[dir]) * WordStep;
+}
+
+inline quint32* GomokuBitboard::array(Array array, Direction dir)
+{
+	return m_data.data() + (array * DirectionCount + dir) * m_stride;
+}
+
+inline const quint32* GomokuBitboard::array(Array array, Direction dir) const
+{
+	return m_data.constData() + (array * DirectionCount + dir) * m_stride;
+}
+
+inline quint32 GomokuBitboard::line(Side side, Direction dir, int index) const
+{
+	return lines(side, dir)[index];
+}
+
+inline quint32 GomokuBitboard::lineMask(Direction dir, int index) const
+{
+	return array(Masks, dir)[index];
+}
+
+inline quint32 GomokuBitboard::ownedMask(Direction dir, int index) const
+{
+	return array(OwnedMasks, dir)[index];
+}
+
+inline quint32 GomokuBitboard::emptyLine(Direction dir, int index) const
+{
+	return lineMask(dir, index)
+		& ~(line(Side::White, dir, index) | line(Side::Black, dir, index));
+}
+
+inline const quint32* GomokuBitboard::lines(Side side, Direction dir) const
+{
+	return array(side == Side::White ? WhiteLines : BlackLines, dir);
+}
+
+inline const quint32* GomokuBitboard::lineMasks(Direction dir) const
+{
+	return array(Masks, dir);
+}
+
+inline const quint32* GomokuBitboard::ownedMasks(Direction dir) const
+{
+	return array(OwnedMasks, dir);
+}
+
+inline bool GomokuBitboard::hasStone(Side side, int file, int rank) const
+{
+	return (line(side, Horizontal, lineIndex(Horizontal, file, rank))
+		>> lineBit(Horizontal, file, rank)) & 1;
+}
+
+inline Side GomokuBitboard::sideAt(int file, int rank) const
+{
+	const int index = lineIndex(Horizontal, file, rank);
+	const int bit = lineBit(Horizontal, file, rank);
+	if ((line(Side::Black, Horizontal, index) >> bit) & 1)
+		return Side::Black;
+	if ((line(Side::White, Horizontal, index) >> bit) & 1)
+		return Side::White;
+	return Side::NoSide;
+}
+
+inline quint32 GomokuBitboard::runStarts(quint32 bits, int length)
+{
+	for (int i = 1; i < length; i++)
+		bits &= bits >> 1;
+	return bits;
+}
+
+inline int GomokuBitboard::popCount(quint32 bits)
+{
+	return qPopulationCount(bits);
+}
+
+inline int GomokuBitboard::lowestBit(quint32 bits)
+{
+	Q_ASSERT(bits != 0);
+	return qPopulationCount((bits & (0u - bits)) - 1);
+}
+
+} // namespace Chess
+#endif // GOMOKUBITBOARD_H
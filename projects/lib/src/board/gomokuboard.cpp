@@ -1,12 +1,16 @@
 
 #include "gomokuboard.h"
-#include "westernzobrist.h"
+#include "gomokuzobrist.h"
 #include <QStringList>
-#include <iostream>
+#include <cstring>
+#include "trace.h"
 
 namespace {
 
-	const int MAX_GOMUKUBOARD_SIZE = 32;
+	// Steps along the lines of each GomokuBitboard::Direction
+	const int s_lineOffsets[Chess::GomokuBitboard::DirectionCount][2] = {
+		{ 1, 0 }, { 0, 1 }, { 1, 1 }, { 1, -1 }
+	};
 
 }
 
@@ -22,13 +26,20 @@ GomokuBoard::GomokuBoard(int sz)
 {
 }
 
-GomokuBoard::GomokuBoard(int wd, int ht) : Board()
+GomokuBoard::GomokuBoard(int wd, int ht)
+	: Board(),
+	  m_zobrist(new GomokuZobrist),
+	  m_sharedZobrist(m_zobrist)
 {
 	this->m_initialized = false;
+	this->m_key = 0;
 	this->m_width = wd;
 	this->m_height = ht;
 	this->m_side = Side::Black;
 	this->m_startingSide = Side::Black;
+	this->m_resultPly = -1;
+	this->m_plyOffset = 0;
+	this->m_traceId = Trace::nextId();
 
 	setPieceType(Piece::NoPiece, QString(), QString());
 	setPieceType(Stone, tr("stone"), "P");
@@ -79,18 +90,19 @@ Piece GomokuBoard::pieceAt(const Square& square) const
 
 void GomokuBoard::initialize()
 {
-	std::cout << "call GomokuBoard::initialize" << std::endl;
 	if (m_initialized)
 		return;
+	ccTrace(lcGomokuBoard).noquote() << tracePrefix() << "initialize"
+		<< m_width << "x" << m_height;
 
 	m_initialized = true;
-	m_squares.clear();
+	m_bitboard.clear(m_width, m_height);
+	m_emptySquares.fill(m_width * m_height);
+
+	// The keys don't depend on the board size, so the board can
+	// be resized later
+	m_zobrist->initialize(Move::MaxSquare + 1, m_pieceData.size());
 
-	int possibleMaxSize = MAX_GOMUKUBOARD_SIZE * MAX_GOMUKUBOARD_SIZE;
-	for (int i = 0; i < possibleMaxSize; i++) {
-		m_squares.append(Piece::WallPiece);
-	}
-		
 	vInitialize();
 
 	m_maxPieceSymbolLength = 1;
@@ -227,9 +239,10 @@ int GomokuBoard::squareIndex(const Square& square) const
 
 bool GomokuBoard::isValidSquare(const Chess::Square& square) const
 {
-	if (square.file() >= m_width || 
-			square.rank() >= m_height) {
-		std::cout << "InvalidSq: " << square.file() << " " << square.rank() << std::endl;
+	if (square.file() < 0 || square.file() >= m_width ||
+	    square.rank() < 0 || square.rank() >= m_height) {
+		ccTraceVerbose(lcGomokuBoard).noquote() << tracePrefix()
+			<< "invalid square" << square.file() << square.rank();
 		return false;
 	}
 	return true;
@@ -246,32 +259,33 @@ QString GomokuBoard::squareString(const Square& square) const
 		return QString();
 	}
 
-	QString str;
-	str += QChar('a' + square.file());
-	str += QChar('a' + square.rank());
-	return str;
+	return QString("%1,%2").arg(square.file()).arg(square.rank());
 }
 
 Square GomokuBoard::chessSquare(const QString& str) const
 {
-	if (str.length() < 2)
-		return Square();
-
-	bool ok = false;
-	int file = 0;
-	int rank = 0;
-
-	file = str.at(0).toLatin1() - 'a';
-	rank = str.at(1).toLatin1() - 'a';
-
-	if (file >= 0 && file < m_width &&
-	    rank >= 0 && rank < m_height) {
-		ok = true;
+	int file = -1;
+	int rank = -1;
+	const int comma = str.indexOf(',');
+
+	if (comma > 0) {
+		// "file,rank", the format of move strings
+		bool fOk = false;
+		bool rOk = false;
+		file = str.leftRef(comma).toInt(&fOk);
+		rank = str.midRef(comma + 1).toInt(&rOk);
+		if (!fOk || !rOk)
+			return Square();
+	} else if (str.length() == 2) {
+		// The old two-letter format of boards up to 26x26
+		file = str.at(0).toLatin1() - 'a';
+		rank = str.at(1).toLatin1() - 'a';
 	}
 
-	if (!ok)
+	const Square square(file, rank);
+	if (!isValidSquare(square))
 		return Square();
-	return Square(file, rank);
+	return square;
 }
 
 int GomokuBoard::squareIndex(const QString& str) const
@@ -297,28 +311,17 @@ QString GomokuBoard::moveString(const Move& move, MoveNotation notation)
 
 Move GomokuBoard::moveFromLanString(const QString& istr)
 {
-	QString str(istr);
-	int commaIdx = str.indexOf(',');
-
-	bool fOk = false;
-	bool rOk = false;
-	QString fstr = str.left(commaIdx);
-	QString rstr = str.mid(commaIdx + 1, -1);
-	int file = fstr.toInt(&fOk);
-	int rank = rstr.toInt(&rOk);
-
-	std::cout << "[" << fstr.toStdString() << "] [" << rstr.toStdString() << "]" << std::endl;
-	std::cout << file << " " << rank << std::endl;
-
-	if (fOk && rOk) {
-		Square sq = Square(file, rank);
-		if (isValidSquare(sq)) {
-			std::cout << squareIndex(sq) << std::endl;
-			return Move(squareIndex(sq), squareIndex(sq), Piece::WallPiece);
+	if (istr.contains(',')) {
+		const Square sq = chessSquare(istr);
+		if (sq.isValid()) {
+			const int index = squareIndex(sq);
+			return Move(index, index, Piece::WallPiece);
 		}
 	}
 
 	// invalid move
+	ccTrace(lcGomokuBoard).noquote() << tracePrefix()
+		<< "invalid move string" << istr;
 	return Move();
 }
 
@@ -347,16 +350,18 @@ GenericMove GomokuBoard::genericMove(const Move& move) const
 QStringList GomokuBoard::pieceList(Side side) const
 {
 	QStringList list;
-	for (int file = 0; file < height(); file++) {
-		for (int rank = 0; rank < width(); rank++) {
-			Square sq = Chess::Square(file, rank);
-			const Piece piece = pieceAt(sq);
-			if (piece.side() != side)
-				continue;
-
-			QString s = pieceSymbol(piece).toUpper();
-			s.append(squareString(sq));
-			list.append(s);
+	const QString symbol = pieceSymbol(Piece(side, Stone)).toUpper();
+
+	const GomokuBitboard::Direction dir = GomokuBitboard::Horizontal;
+	for (int index = 0; index < m_bitboard.lineCount(dir); index++) {
+		const int rank = m_bitboard.boardLine(dir, index);
+		const int offset = m_bitboard.lineOffset(dir, index);
+		quint32 stones = m_bitboard.line(side, dir, index)
+			       & m_bitboard.ownedMask(dir, index);
+		while (stones) {
+			int file = offset + GomokuBitboard::lowestBit(stones);
+			stones &= stones - 1;
+			list.append(symbol + squareString(Square(file, rank)));
 		}
 	}
 	return list;
@@ -365,39 +370,43 @@ QStringList GomokuBoard::pieceList(Side side) const
 QString GomokuBoard::fenString(FenNotation notation) const
 {
 	QString fen;
-
-	// Squares
-	int i = (m_width + 2) * 2;
-	for (int y = 0; y < m_height; y++)
+	const QString symbol[2] = {
+		pieceSymbol(Piece(Side::White, Stone)),
+		pieceSymbol(Piece(Side::Black, Stone))
+	};
+
+	// Squares, from the last rank to the first. The words of a
+	// rank are consecutive and go from the first file to the last.
+	const GomokuBitboard::Direction dir = GomokuBitboard::Horizontal;
+	const int words = m_bitboard.lineCount(dir) / m_height;
+	for (int rank = m_height - 1; rank >= 0; rank--)
 	{
-		int nempty = 0;
-		i++;
-		if (y > 0)
+		if (rank < m_height - 1)
 			fen += '/';
-		for (int x = 0; x < m_width; x++)
-		{
-			Piece pc = m_squares[i];
 
-			if (pc.isEmpty())
-				nempty++;
+		int file = 0;
+		for (int index = rank * words; index < (rank + 1) * words; index++)
+		{
+			const int offset = m_bitboard.lineOffset(dir, index);
+			quint32 white = m_bitboard.line(Side::White, dir, index);
+			quint32 black = m_bitboard.line(Side::Black, dir, index);
+			quint32 stones = (white | black) & m_bitboard.ownedMask(dir, index);
 
-			// Add the number of empty successive squares
-			// to the FEN string.
-			if (nempty > 0
-			&&  (!pc.isEmpty() || x == m_width - 1))
+			while (stones)
 			{
-				fen += QString::number(nempty);
-				nempty = 0;
+				int bit = GomokuBitboard::lowestBit(stones);
+				stones &= stones - 1;
+
+				// Add the number of empty successive squares
+				// to the FEN string.
+				if (offset + bit > file)
+					fen += QString::number(offset + bit - file);
+				fen += symbol[((black >> bit) & 1) ? Side::Black : Side::White];
+				file = offset + bit + 1;
 			}
-
-			if (pc.isValid())
-				fen += pieceSymbol(pc);
-			else if (pc.isWall())
-				fen += "*";
-
-			i++;
 		}
-		i++;
+		if (file < m_width)
+			fen += QString::number(m_width - file);
 	}
 
 	// Side to move
@@ -581,13 +590,14 @@ void GomokuBoard::reset()
 {
 	setFenString(defaultFenString());
 
-	for (int i = 0; i < m_squares.size(); i++) {
-		Piece &pc = m_squares[i];
-		pc = Piece::NoPiece;
-	}
+	m_bitboard.clear(m_width, m_height);
+	m_emptySquares.fill(m_width * m_height);
 
 	m_side = Side::Black;
+	m_key = 0;
 	m_moveHistory.clear();
+	m_plyOffset = 0;
+	m_resultPly = -1;
 }
 
 void GomokuBoard::makeMove(const Move& move, BoardTransition* transition)
@@ -600,11 +610,13 @@ void GomokuBoard::makeMove(const Move& move, BoardTransition* transition)
 	vMakeMove(move, transition);
 
 	m_side = m_side.opposite();
+	xorKey(m_zobrist->side());
 	m_moveHistory << md;
 
-	showBoard();
-	std::cout << "MoveHistLength: " << m_moveHistory.size() << std::endl;
-
+	ccTrace(lcGomokuBoard).noquote() << tracePrefix() << "ply"
+		<< m_moveHistory.size() << lanMoveString(move);
+	if (ccTraceVerboseEnabled(lcGomokuBoard))
+		showBoard();
 }
 
 void GomokuBoard::undoMove()
@@ -617,19 +629,68 @@ void GomokuBoard::undoMove()
 
 	m_key = m_moveHistory.last().key;
 	m_moveHistory.pop_back();
+
+	// The cached result belongs to the position we just left
+	m_resultPly = -1;
 }
 
 void GomokuBoard::generateMoves(QVarLengthArray<Move>& moves, int pieceType) const
 {
 	Q_ASSERT(!m_side.isNull());
+	Q_UNUSED(pieceType);
+
+	const int count = m_emptySquares.count();
+	moves.reserve(moves.size() + count);
+	for (int i = 0; i < count; i++) {
+		const int sq = m_emptySquares.at(i);
+		moves.append(Move(sq, sq, Piece::WallPiece));
+	}
+}
+
+QVector<Move> GomokuBoard::candidateMoves(int distance) const
+{
+	Q_ASSERT(distance >= 0);
+
+	QVector<Move> moves;
+	if (m_emptySquares.count() == m_width * m_height) {
+		const int sq = (m_height / 2) * m_width + m_width / 2;
+		moves << Move(sq, sq, Piece::WallPiece);
+		return moves;
+	}
 
-	for (int i = 0; i < m_squares.size(); i++) {
-		Piece pc = m_squares[i];
-		if (pc == Piece::NoPiece) {
-			moves.append(Move(i, i, Piece::WallPiece));
+	// Mark the squares around every stone
+	QVarLengthArray<bool, 1024> near(m_width * m_height);
+	std::fill(near.begin(), near.end(), false);
+
+	const GomokuBitboard::Direction dir = GomokuBitboard::Horizontal;
+	for (int index = 0; index < m_bitboard.lineCount(dir); index++) {
+		const int rank = m_bitboard.boardLine(dir, index);
+		const int offset = m_bitboard.lineOffset(dir, index);
+		quint32 stones = (m_bitboard.line(Side::Black, dir, index)
+				| m_bitboard.line(Side::White, dir, index))
+			       & m_bitboard.ownedMask(dir, index);
+
+		while (stones) {
+			const int file = offset + GomokuBitboard::lowestBit(stones);
+			stones &= stones - 1;
+
+			const int firstFile = qMax(0, file - distance);
+			const int lastFile = qMin(m_width - 1, file + distance);
+			const int firstRank = qMax(0, rank - distance);
+			const int lastRank = qMin(m_height - 1, rank + distance);
+			for (int r = firstRank; r <= lastRank; r++) {
+				bool* row = near.data() + r * m_width;
+				std::fill(row + firstFile, row + lastFile + 1, true);
+			}
 		}
 	}
 
+	for (int sq = 0; sq < near.size(); sq++) {
+		if (near[sq] && m_emptySquares.contains(sq))
+			moves << Move(sq, sq, Piece::WallPiece);
+	}
+
+	return moves;
 }
 
 void GomokuBoard::generateDropMoves(QVarLengthArray<Move>& moves, int pieceType) const
@@ -655,15 +716,10 @@ bool GomokuBoard::moveExists(const Move& move) const
 {
 	Q_ASSERT(!move.isNull());
 
-	QVarLengthArray<Move> moves;
-	generateMoves(moves);
-
-	for (int i = 0; i < moves.size(); i++) {
-		if (moves[i] == move) {
-			return true;
-		}
-	}
-	return false;
+	const int sq = move.targetSquare();
+	return move.sourceSquare() == sq
+	    && move.promotion() == Piece::WallPiece
+	    && m_emptySquares.contains(sq);
 }
 
 int GomokuBoard::captureType(const Move& move) const
@@ -674,8 +730,7 @@ int GomokuBoard::captureType(const Move& move) const
 
 bool GomokuBoard::vIsLegalMove(const Move& move)
 {
-	int targetSq = move.targetSquare();
-	if (pieceAt(chessSquare(targetSq)) != Piece::NoPiece) { // only possible to place stone on empty square
+	if (!m_emptySquares.contains(move.targetSquare())) { // only possible to place stone on empty square
 		return false;
 	}
 /*
@@ -689,7 +744,7 @@ bool GomokuBoard::vIsLegalMove(const Move& move)
 
 bool GomokuBoard::isLegalMove(const Move& move)
 {
-	return vIsLegalMove(move);
+	return !move.isNull() && moveExists(move) && vIsLegalMove(move);
 }
 
 int GomokuBoard::repeatCount() const
@@ -768,46 +823,105 @@ QString GomokuBoard::defaultFenString() const {
 
 Result GomokuBoard::result() {
 
-	QString str;
+	// The result can only change when a stone is placed, so it is
+	// computed once per ply and reused until the next move or undo.
+	if (m_resultPly == plyCount())
+		return m_result;
+
+	m_result = Result();
+	m_resultPly = plyCount();
+
+	// Win: Five-connection. Only the stone placed last can have
+	// completed one, so only the four lines through it are checked.
+	if (!m_moveHistory.isEmpty()) {
+		Square lastSq = chessSquare(lastMove().targetSquare());
+		if (isPartOfFive(lastSq)) {
+			Side winner = pieceAt(lastSq).side();
+			QString str = tr("%1 wins by five connections").arg(winner.toString());
+			m_result = Result(Result::Win, winner, str);
+			return m_result;
+		}
+	} else if (m_plyOffset > 0) {
+		// Restored with setPosition(): the last move is unknown,
+		// so the whole board has to be searched.
+		const auto fives = findFiveConnections();
+		if (!fives.isEmpty()) {
+			Side winner = fives.first().color;
+			QString str = tr("%1 wins by five connections").arg(winner.toString());
+			m_result = Result(Result::Win, winner, str);
+			return m_result;
+		}
+	}
+
+	// Draw: Board is full
+	if (m_emptySquares.isEmpty()) {
+		m_result = Result(Result::Draw, Side::NoSide, "Wokelipangdiu");
+	}
+
+	return m_result;
+}
+
+GomokuBitboard::Direction GomokuBoard::lineDirection(int fileOffset,
+						      int rankOffset) {
+
+	Q_ASSERT(fileOffset != 0 || rankOffset != 0);
 
-	// Win: Five-connection
-	QVector<FiveConnectionInfo> fiveConns = findFiveConnections();
-	//Q_ASSERT(fiveConns.size() <= 1); // commented out in case there is long connections (connections of more than 6)
+	if (rankOffset == 0)
+		return GomokuBitboard::Horizontal;
+	if (fileOffset == 0)
+		return GomokuBitboard::Vertical;
+	if (fileOffset == rankOffset)
+		return GomokuBitboard::Diagonal;
+	return GomokuBitboard::AntiDiagonal;
+}
 
-	if (fiveConns.size() > 0) {
-		//Q_ASSERT(fiveConns.size() == 1);
+int GomokuBoard::connectionLength(const Square& square,
+				  int fileOffset,
+				  int rankOffset) const {
 
-		GomokuBoard::FiveConnectionInfo winFive = fiveConns[0];
-		Side winner = winFive.color;
-		str = tr("%1 wins by five connections").arg(winner.toString());
-		return Result(Result::Win, winner, str);
+	Side side = m_bitboard.sideAt(square.file(), square.rank());
+	if (side.isNull()) {
+		return 0;
 	}
 
-	// Draw: Board is full
-	int maxMoves = width() * height();
-	if (plyCount() >= maxMoves) {
-		return Result(Result::Draw, Side::NoSide, "Wokelipangdiu");
+	return m_bitboard.connectionLength(side,
+					   lineDirection(fileOffset, rankOffset),
+					   square.file(),
+					   square.rank());
+}
+
+bool GomokuBoard::isPartOfFive(const Square& square) const {
+
+	Side side = m_bitboard.sideAt(square.file(), square.rank());
+	if (side.isNull()) {
+		return false;
 	}
 
-	return Result();
+	return m_bitboard.isPartOfFive(side, square.file(), square.rank());
 }
 
 QVector<GomokuBoard::FiveConnectionInfo> GomokuBoard::findFiveConnections() {
 
 	QVector<FiveConnectionInfo> fives;
-	int foffset = 0, roffset = 0;
-	
-	foffset = 1;
-	roffset = 0;
-	for (int i = 0; i < (m_width - 4); i++) {
-		for (int j = 0; j < m_height; j++) {
-			Square sq = Square(i, j);
-			Piece pc = pieceAt(sq);
-			if (pc != Piece::NoPiece) {
-				bool isFive = checkFiveConnection(sq, foffset, roffset);
-				if (isFive) {
-					GomokuBoard::FiveConnectionInfo fInfo = { 
-						sq, pc.side(), foffset, roffset 
+	PatternMatches matches;
+	const int stride = m_bitboard.lineStride();
+
+	for (int dir = 0; dir < GomokuBitboard::DirectionCount; dir++) {
+		GomokuBitboard::Direction d = GomokuBitboard::Direction(dir);
+
+		for (int side = Side::White; side <= Side::Black; side++) {
+			Side color = Side::Type(side);
+			classifyLines(color, d, matches);
+
+			for (int index = 0; index < m_bitboard.lineCount(d); index++) {
+				quint32 starts = matches[GomokuPatterns::Five * stride + index];
+				while (starts) {
+					int bit = GomokuBitboard::lowestBit(starts);
+					starts &= starts - 1;
+
+					GomokuBoard::FiveConnectionInfo fInfo = {
+						lineSquare(d, index, bit), color,
+						s_lineOffsets[dir][0], s_lineOffsets[dir][1]
 					};
 					fives.push_back(fInfo);
 				}
@@ -815,61 +929,90 @@ QVector<GomokuBoard::FiveConnectionInfo> GomokuBoard::findFiveConnections() {
 		}
 	}
 
-	foffset = 0;
-	roffset = 1;
-	for (int i = 0; i < m_width; i++) {
-		for (int j = 0; j < (m_height - 4); j++) {
-			Square sq = Square(i, j);
-			Piece pc = pieceAt(sq);
-			if (pc != Piece::NoPiece) {
-				bool isFive = checkFiveConnection(sq, foffset, roffset);
-				if (isFive) {
-					GomokuBoard::FiveConnectionInfo fInfo = { 
-						sq, pc.side(), foffset, roffset 
+	return fives;
+}
+
+QVector<GomokuBoard::ThreatInfo> GomokuBoard::threats(Side side) const {
+
+	Q_ASSERT(!side.isNull());
+
+	QVector<ThreatInfo> threats;
+	PatternMatches matches;
+	const int stride = m_bitboard.lineStride();
+
+	for (int dir = 0; dir < GomokuBitboard::DirectionCount; dir++) {
+		GomokuBitboard::Direction d = GomokuBitboard::Direction(dir);
+		classifyLines(side, d, matches);
+
+		for (int type = 0; type < GomokuPatterns::PatternCount; type++) {
+			for (int index = 0; index < m_bitboard.lineCount(d); index++) {
+				quint32 starts = matches[type * stride + index];
+				while (starts) {
+					int bit = GomokuBitboard::lowestBit(starts);
+					starts &= starts - 1;
+
+					ThreatInfo info = {
+						GomokuPatterns::Pattern(type),
+						lineSquare(d, index, bit),
+						s_lineOffsets[dir][0], s_lineOffsets[dir][1]
 					};
-					fives.push_back(fInfo);
+					threats.push_back(info);
 				}
 			}
 		}
 	}
 
-	foffset = 1;
-	roffset = 1;
-	for (int i = 0; i < (m_width - 4); i++) {
-		for (int j = 0; j < (m_height - 4); j++) {
-			Square sq = Square(i, j);
-			Piece pc = pieceAt(sq);
-			if (pc != Piece::NoPiece) {
-				bool isFive = checkFiveConnection(sq, foffset, roffset);
-				if (isFive) {
-					GomokuBoard::FiveConnectionInfo fInfo = { 
-						sq, pc.side(), foffset, roffset 
-					};
-					fives.push_back(fInfo);
-				}
-			}
-		}
+	return threats;
+}
+
+void GomokuBoard::classifyLines(Side side,
+				GomokuBitboard::Direction dir,
+				PatternMatches& matches) const {
+
+	const int stride = m_bitboard.lineStride();
+	const int count = m_bitboard.lineCount(dir);
+	matches.resize(GomokuPatterns::PatternCount * stride);
+
+	quint32* const out[GomokuPatterns::PatternCount] = {
+		matches.data() + GomokuPatterns::Five * stride,
+		matches.data() + GomokuPatterns::OpenFour * stride,
+		matches.data() + GomokuPatterns::Four * stride,
+		matches.data() + GomokuPatterns::OpenThree * stride,
+		matches.data() + GomokuPatterns::BrokenThree * stride
+	};
+
+	GomokuPatterns::classify(m_bitboard.lines(side, dir),
+				 m_bitboard.lines(side.opposite(), dir),
+				 m_bitboard.lineMasks(dir),
+				 count,
+				 out);
+
+	// Lines longer than one word are covered by overlapping words;
+	// keep each match only in the word that owns its first square.
+	const quint32* owned = m_bitboard.ownedMasks(dir);
+	for (int type = 0; type < GomokuPatterns::PatternCount; type++) {
+		for (int index = 0; index < count; index++)
+			out[type][index] &= owned[index];
 	}
+}
 
-	foffset = 1;
-	roffset = -1;
-	for (int i = 0; i < (m_width - 4); i++) {
-		for (int j = 4; j < m_height; j++) {
-			Square sq = Square(i, j);
-			Piece pc = pieceAt(sq);
-			if (pc != Piece::NoPiece) {
-				bool isFive = checkFiveConnection(sq, foffset, roffset);
-				if (isFive) {
-					GomokuBoard::FiveConnectionInfo fInfo = { 
-						sq, pc.side(), foffset, roffset 
-					};
-					fives.push_back(fInfo);
-				}
-			}
-		}
+Square GomokuBoard::lineSquare(GomokuBitboard::Direction dir,
+			       int index,
+			       int bit) const {
+
+	const int line = m_bitboard.boardLine(dir, index);
+	const int pos = m_bitboard.lineOffset(dir, index) + bit;
+
+	switch (dir) {
+	case GomokuBitboard::Horizontal:
+		return Square(pos, line);
+	case GomokuBitboard::Vertical:
+		return Square(line, pos);
+	case GomokuBitboard::Diagonal:
+		return Square(pos, pos - line + m_height - 1);
+	default:
+		return Square(pos, line - pos);
 	}
-	
-	return fives;
 }
 
 bool GomokuBoard::checkFiveConnection(Square &sq, int fileOffset, int rankOffset) {
@@ -968,7 +1111,50 @@ QString GomokuBoard::startingFenString() const
 
 quint64 GomokuBoard::key() const
 {
-	return 0;
+	return m_key;
+}
+
+quint64 GomokuBoard::canonicalKey() const
+{
+	// Symmetry bits: 1 mirrors the files, 2 mirrors the ranks and
+	// 4 swaps files and ranks (only possible on square boards).
+	const int symmetryCount = (m_width == m_height) ? 8 : 4;
+	quint64 keys[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+	for (int side = Side::White; side <= Side::Black; side++)
+	{
+		const Piece pc(Side::Type(side), Stone);
+		const GomokuBitboard::Direction dir = GomokuBitboard::Horizontal;
+		for (int index = 0; index < m_bitboard.lineCount(dir); index++)
+		{
+			const int rank = m_bitboard.boardLine(dir, index);
+			const int offset = m_bitboard.lineOffset(dir, index);
+			quint32 stones = m_bitboard.line(pc.side(), dir, index)
+				       & m_bitboard.ownedMask(dir, index);
+			while (stones)
+			{
+				const int file = offset + GomokuBitboard::lowestBit(stones);
+				stones &= stones - 1;
+
+				for (int sym = 0; sym < symmetryCount; sym++)
+				{
+					int f = (sym & 1) ? m_width - 1 - file : file;
+					int r = (sym & 2) ? m_height - 1 - rank : rank;
+					if (sym & 4)
+						qSwap(f, r);
+					keys[sym] ^= m_zobrist->piece(pc, r * m_width + f);
+				}
+			}
+		}
+	}
+
+	quint64 key = keys[0];
+	for (int sym = 1; sym < symmetryCount; sym++)
+		key = qMin(key, keys[sym]);
+
+	if (m_side == Side::White)
+		key ^= m_zobrist->side();
+	return key;
 }
 
 void GomokuBoard::xorKey(quint64 key)
@@ -978,18 +1164,105 @@ void GomokuBoard::xorKey(quint64 key)
 
 Piece GomokuBoard::pieceAt(int square) const
 {
-	return m_squares[square];
+	if (square < 0 || square >= m_width * m_height)
+		return Piece::WallPiece;
+
+	Side side = m_bitboard.sideAt(square % m_width, square / m_width);
+	if (side.isNull())
+		return Piece::NoPiece;
+	return Piece(side, Stone);
 }
 
 void GomokuBoard::setSquare(int square, Piece piece)
 {
-	Piece& old = m_squares[square];
-	old = piece;
+	Q_ASSERT(square >= 0 && square < m_width * m_height);
+
+	const int file = square % m_width;
+	const int rank = square / m_width;
+	const Piece old = pieceAt(square);
+
+	if (old.isValid())
+	{
+		xorKey(m_zobrist->piece(old, square));
+		m_bitboard.clearStone(old.side(), file, rank);
+		m_emptySquares.insert(square);
+	}
+	if (piece.isValid())
+	{
+		xorKey(m_zobrist->piece(piece, square));
+		m_bitboard.setStone(piece.side(), file, rank);
+		m_emptySquares.remove(square);
+	}
 }
 
 int GomokuBoard::plyCount() const
 {
-	return m_moveHistory.size();
+	return m_plyOffset + m_moveHistory.size();
+}
+
+GomokuPosition GomokuBoard::position() const
+{
+	const GomokuBitboard::Direction dir = GomokuBitboard::Horizontal;
+
+	// Rows wider than a line word are split into several words,
+	// and every square is taken from the word that owns it
+	GomokuPosition pos;
+	memset(pos.stones, 0, sizeof(pos.stones));
+	for (int side = Side::White; side <= Side::Black; side++)
+	{
+		for (int i = 0; i < m_bitboard.lineCount(dir); i++)
+		{
+			quint32 bits = m_bitboard.line(Side::Type(side), dir, i)
+				     & m_bitboard.ownedMask(dir, i);
+			const int first = m_bitboard.boardLine(dir, i) * m_width
+					+ m_bitboard.lineOffset(dir, i);
+			while (bits)
+			{
+				const int square = first + GomokuBitboard::lowestBit(bits);
+				bits &= bits - 1;
+				pos.stones[side][square / 64] |= Q_UINT64_C(1) << (square % 64);
+			}
+		}
+	}
+	pos.key = m_key;
+	pos.ply = quint16(plyCount());
+	pos.width = quint16(m_width);
+	pos.height = quint16(m_height);
+	pos.sideToMove = quint8(Side::Type(m_side));
+
+	return pos;
+}
+
+void GomokuBoard::setPosition(const GomokuPosition& position)
+{
+	Q_ASSERT(isValidSize(position.width, position.height));
+
+	m_width = position.width;
+	m_height = position.height;
+	reset();
+
+	for (int side = Side::White; side <= Side::Black; side++)
+	{
+		const Piece pc(Side::Type(side), Stone);
+		for (int i = 0; i < GomokuPosition::WordCount; i++)
+		{
+			quint64 stones = position.stones[side][i];
+			while (stones)
+			{
+				const int square = i * 64 + qCountTrailingZeroBits(stones);
+				stones &= stones - 1;
+				Q_ASSERT(square < m_width * m_height);
+				setSquare(square, pc);
+			}
+		}
+	}
+
+	m_side = Side::Type(position.sideToMove);
+	if (m_side == Side::White)
+		xorKey(m_zobrist->side());
+	m_plyOffset = position.ply;
+
+	Q_ASSERT(m_key == position.key);
 }
 
 const Move& GomokuBoard::lastMove() const
@@ -1005,18 +1278,34 @@ int GomokuBoard::height() const {
   return m_height;
 }
 
+bool GomokuBoard::isGomokuVariant(const QString& variant) {
+	return variant == "gomoku"
+	    || variant == "gomoku-standard"
+	    || variant == "caro"
+	    || variant == "renju";
+}
+
+bool GomokuBoard::isValidSize(int width, int height) {
+	return width > 0 && height > 0
+	    && width * height <= Move::MaxSquare + 1;
+}
+
 void GomokuBoard::setWidth(int wd) {
-	Q_ASSERT(wd > 0 && wd < 32);
+	Q_ASSERT(wd > 0);
 	m_width = wd;
+
+	// The bitboard masks depend on the board size
+	reset();
 }
 
 void GomokuBoard::setHeight(int ht) {
-	Q_ASSERT(ht > 0 && ht < 32);
+	Q_ASSERT(ht > 0);
 	m_height = ht;
+	reset();
 }
 
 void GomokuBoard::setSize(int sz) {
-	Q_ASSERT(sz > 0 && sz < 32);
+	Q_ASSERT(isValidSize(sz, sz));
 	setWidth(sz);
 	setHeight(sz);
 }
@@ -1024,45 +1313,46 @@ void GomokuBoard::setSize(int sz) {
 QVector<Move> GomokuBoard::getHistoricalMoves()
 {
 	QVector<Move> histMoves;
-	for (int i = m_moveHistory.size() - 1; i >= 0; i--) {
-		histMoves << m_moveHistory[i].move;
+	histMoves.reserve(m_moveHistory.size());
+	for (const MoveData& md : m_moveHistory) {
+		histMoves << md.move;
 	}
 	return histMoves;
 }
 
-void GomokuBoard::showBoard() {
-
-	int w = width();
-	int h = height();
-
-	std::cout << "========================================" << std::endl;
-	for (int i = 0; i < w; i++) {
-		for (int j = 0; j < h; j++) {
-			std::string cell = ". ";
-			Piece pc = pieceAt(Square(i, j));
-			if (pc == Piece::NoPiece) {
-
-			} else if (pc.side() == Side::White) {
-				cell = "O ";
-			} else if (pc.side() == Side::Black) {
-				cell = "X ";
-			}
-			//std::cout << pc.type() << " ";
-			std::cout << cell; 
+void GomokuBoard::showBoard()
+{
+	QString diagram;
+	for (int rank = m_height - 1; rank >= 0; rank--)
+	{
+		for (int file = 0; file < m_width; file++)
+		{
+			const Side side = m_bitboard.sideAt(file, rank);
+			if (side == Side::Black)
+				diagram += "X ";
+			else if (side == Side::White)
+				diagram += "O ";
+			else
+				diagram += ". ";
 		}
-		std::cout << std::endl;
-	}
-	std::cout << "SideToMove: " << sideToMove() << std::endl;
-	std::cout << "Ply: " << m_moveHistory.size() << std::endl;
-	std::cout << "Moves: ";
-	for (int k = 0; k < m_moveHistory.size(); k++) {
-		MoveNotation nota;
-		QString mstr = moveString(m_moveHistory[k].move, nota);
-		std::cout << mstr.toStdString() << " ";
+		diagram += '\n';
 	}
-	std::cout << std::endl;
-	std::cout << "========================================" << std::endl;
 
+	QStringList moves;
+	for (const MoveData& md : m_moveHistory)
+		moves << lanMoveString(md.move);
+
+	ccTraceVerbose(lcGomokuBoard).noquote()
+		<< tracePrefix() << "position\n"
+		<< diagram
+		<< "side to move:" << m_side.toString()
+		<< "ply:" << m_moveHistory.size()
+		<< "\nmoves:" << moves.join(' ');
+}
+
+QString GomokuBoard::tracePrefix() const
+{
+	return QString("[gomoku #%1]").arg(m_traceId);
 }
 
 } // namespace Chess
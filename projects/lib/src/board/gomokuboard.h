@@ -15,6 +15,10 @@
 #include "result.h"
 #include "board.h"
 #include "boardtransition.h"
+#include "gomokubitboard.h"
+#include "gomokupatterns.h"
+#include "gomokusquareset.h"
+#include "gomokuposition.h"
 class QStringList;
 
 
@@ -39,6 +43,20 @@ class LIB_EXPORT GomokuBoard : public Board
 			int rankOffset;
 		};
 
+		/*!
+		 * A line pattern found by threats().
+		 *
+		 * The pattern starts on \a startSq and continues in
+		 * direction (\a fileOffset, \a rankOffset).
+		 */
+		struct ThreatInfo
+		{
+			GomokuPatterns::Pattern type;
+			Square startSq;
+			int fileOffset;
+			int rankOffset;
+		};
+
 		GomokuBoard();
 		GomokuBoard(int sz);
 		GomokuBoard(int wd, int ht);
@@ -229,6 +247,19 @@ class LIB_EXPORT GomokuBoard : public Board
 		 */
 		Result tablebaseResult(unsigned int* dtm = nullptr) const;
 
+		/*!
+		 * Returns true if \a variant is played on a GomokuBoard
+		 * or one of its subclasses.
+		 */
+		static bool isGomokuVariant(const QString& variant);
+
+		/*!
+		 * Returns true if a \a width x \a height board is
+		 * supported. The number of squares is limited by the
+		 * Move encoding to Move::MaxSquare + 1.
+		 */
+		static bool isValidSize(int width, int height);
+
 		void setWidth(int wd);
 
 		void setHeight(int ht);
@@ -239,6 +270,48 @@ class LIB_EXPORT GomokuBoard : public Board
 
 		Square chessSquarePublic(int index) const;
 
+		/*!
+		 * Returns a zobrist key that is the same for all positions
+		 * that are mirror images or rotations of each other.
+		 *
+		 * The key is the smallest key of the (up to) 8 symmetric
+		 * variations of the current position. Rectangular boards
+		 * only have 4 symmetries, because they can't be transposed.
+		 */
+		quint64 canonicalKey() const;
+
+		/*!
+		 * Returns the fives, fours and threes of \a side in all
+		 * four directions.
+		 *
+		 * \sa GomokuPatterns
+		 */
+		QVector<ThreatInfo> threats(Side side) const;
+
+		/*!
+		 * Returns the empty squares that are at most \a distance
+		 * files and ranks away from a stone.
+		 *
+		 * On an empty board the center square is the only
+		 * candidate. The moves are sorted by square index.
+		 */
+		QVector<Move> candidateMoves(int distance) const;
+
+		/*!
+		 * Returns a compact snapshot of the current position.
+		 *
+		 * \sa setPosition()
+		 */
+		GomokuPosition position() const;
+		/*!
+		 * Restores the position in \a position.
+		 *
+		 * The board is resized to the size of \a position if
+		 * needed. The move history is cleared, but plyCount()
+		 * continues from the ply of \a position.
+		 */
+		void setPosition(const GomokuPosition& position);
+
 	protected:
 
 		/*!
@@ -453,11 +526,70 @@ class LIB_EXPORT GomokuBoard : public Board
 		/*! Removes a piece of type \a piece from the reserve. */
 		void removeFromReserve(const Piece& piece);
 
+		/*!
+		 * Writes a diagram of the board and the move list to the
+		 * verbose gomoku trace.
+		 */
 		void showBoard();
+		/*!
+		 * Returns the prefix of this board's trace messages.
+		 *
+		 * Copies of a board share its trace id, so the prefix
+		 * identifies the game rather than the board object.
+		 */
+		QString tracePrefix() const;
 
 
 		QVector<FiveConnectionInfo> findFiveConnections();
 		bool checkFiveConnection(Square &sq, int fileOffset, int rankOffset);
+		/*!
+		 * Returns the bitboard direction that matches the step
+		 * (\a fileOffset, \a rankOffset).
+		 */
+		static GomokuBitboard::Direction lineDirection(int fileOffset,
+							       int rankOffset);
+		/*!
+		 * Returns the square at \a bit of line \a index in
+		 * direction \a dir.
+		 */
+		Square lineSquare(GomokuBitboard::Direction dir,
+				  int index,
+				  int bit) const;
+		/*!
+		 * Pattern matches of the lines of one direction: the
+		 * matches of pattern \a p on line \a i are at index
+		 * p * GomokuBitboard::lineStride() + i.
+		 */
+		typedef QVarLengthArray<quint32, GomokuPatterns::PatternCount * 64> PatternMatches;
+		/*!
+		 * Runs the pattern kernel on the lines of \a side in
+		 * direction \a dir and stores the matches in \a matches.
+		 *
+		 * Each match is reported once, in the line that owns its
+		 * first square.
+		 */
+		void classifyLines(Side side,
+				   GomokuBitboard::Direction dir,
+				   PatternMatches& matches) const;
+		/*!
+		 * Returns the number of consecutive stones of the same
+		 * side as the stone on \a square in the line going through
+		 * \a square in direction (\a fileOffset, \a rankOffset).
+		 *
+		 * Returns 0 if \a square is empty.
+		 */
+		int connectionLength(const Square& square,
+				     int fileOffset,
+				     int rankOffset) const;
+		/*!
+		 * Returns true if the stone on \a square is part of a
+		 * connection of five or more stones in any of the four
+		 * directions.
+		 *
+		 * Unlike findFiveConnections() this only inspects the four
+		 * lines going through \a square.
+		 */
+		bool isPartOfFive(const Square& square) const;
 
 		struct PieceData
 		{
@@ -476,13 +608,20 @@ class LIB_EXPORT GomokuBoard : public Board
 		int m_width;
 		int m_height;
 		quint64 m_key;
+		Zobrist* m_zobrist;
+		QSharedPointer<Zobrist> m_sharedZobrist;
 		Side m_side;
 		Side m_startingSide;
 		QString m_startingFen;
 		int m_maxPieceSymbolLength;
 		QVarLengthArray<PieceData> m_pieceData;
-		QVarLengthArray<Piece> m_squares;
+		GomokuBitboard m_bitboard;
+		GomokuSquareSet m_emptySquares;
 		QVector<MoveData> m_moveHistory;
+		int m_plyOffset;
+		Result m_result;
+		int m_resultPly;
+		int m_traceId;
 };
 
 } // namespace Chess
@@ -0,0 +1,200 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gomokupatterns.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GOMOKUPATTERNS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+using Chess::GomokuPatterns::PatternCount;
+
+/*
+ * Vector operations used by the kernel. Each backend implements the
+ * same set of operations on a vector of 32-bit lanes, one lane per
+ * board line, so the pattern expressions are written only once.
+ */
+struct ScalarOps
+{
+	typedef quint32 Vec;
+	static const int Width = 1;
+
+	static Vec load(const quint32* p) { return *p; }
+	static void store(quint32* p, Vec v) { *p = v; }
+	static Vec andOp(Vec a, Vec b) { return a & b; }
+	static Vec orOp(Vec a, Vec b) { return a | b; }
+	static Vec andNot(Vec a, Vec b) { return ~a & b; }
+	template <int N> static Vec shr(Vec v) { return v >> N; }
+	template <int N> static Vec shl(Vec v) { return v << N; }
+};
+
+#if defined(__AVX2__)
+struct SimdOps
+{
+	typedef __m256i Vec;
+	static const int Width = 8;
+
+	static Vec load(const quint32* p)
+	{ return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+	static void store(quint32* p, Vec v)
+	{ _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+	static Vec andOp(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+	static Vec orOp(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+	static Vec andNot(Vec a, Vec b) { return _mm256_andnot_si256(a, b); }
+	template <int N> static Vec shr(Vec v) { return _mm256_srli_epi32(v, N); }
+	template <int N> static Vec shl(Vec v) { return _mm256_slli_epi32(v, N); }
+};
+#elif defined(GOMOKUPATTERNS_SSE2)
+struct SimdOps
+{
+	typedef __m128i Vec;
+	static const int Width = 4;
+
+	static Vec load(const quint32* p)
+	{ return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+	static void store(quint32* p, Vec v)
+	{ _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+	static Vec andOp(Vec a, Vec b) { return _mm_and_si128(a, b); }
+	static Vec orOp(Vec a, Vec b) { return _mm_or_si128(a, b); }
+	static Vec andNot(Vec a, Vec b) { return _mm_andnot_si128(a, b); }
+	template <int N> static Vec shr(Vec v) { return _mm_srli_epi32(v, N); }
+	template <int N> static Vec shl(Vec v) { return _mm_slli_epi32(v, N); }
+};
+#else
+typedef ScalarOps SimdOps;
+#endif
+
+/*
+ * Classifies the lines starting at 'i'. A pattern starting on square
+ * 'k' matches when every shifted mask has bit 'k' set, ie. when the
+ * square 'k + n' of the line has the property required by the n:th
+ * square of the pattern.
+ */
+template <typename Ops>
+inline void classifyBlock(const quint32* own,
+			  const quint32* opponent,
+			  const quint32* mask,
+			  int i,
+			  quint32* const out[PatternCount])
+{
+	typedef typename Ops::Vec Vec;
+
+	const Vec o0 = Ops::load(own + i);
+	const Vec e0 = Ops::andNot(Ops::orOp(o0, Ops::load(opponent + i)),
+				   Ops::load(mask + i));
+
+	const Vec o1 = Ops::template shr<1>(o0);
+	const Vec o2 = Ops::template shr<2>(o0);
+	const Vec o3 = Ops::template shr<3>(o0);
+	const Vec o4 = Ops::template shr<4>(o0);
+	const Vec e1 = Ops::template shr<1>(e0);
+	const Vec e2 = Ops::template shr<2>(e0);
+	const Vec e3 = Ops::template shr<3>(e0);
+	const Vec e4 = Ops::template shr<4>(e0);
+	const Vec e5 = Ops::template shr<5>(e0);
+
+	const Vec o12 = Ops::andOp(o1, o2);
+	const Vec o34 = Ops::andOp(o3, o4);
+	const Vec o1234 = Ops::andOp(o12, o34);
+
+	// OOOOO
+	const Vec five = Ops::andOp(o0, o1234);
+
+	// .OOOO.
+	const Vec openFour = Ops::andOp(Ops::andOp(e0, o1234), e5);
+
+	// EOOOO, OEOOO, OOEOO, OOOEO and OOOOE
+	Vec four = Ops::andOp(e0, o1234);
+	four = Ops::orOp(four, Ops::andOp(Ops::andOp(o0, e1), Ops::andOp(o2, o34)));
+	four = Ops::orOp(four, Ops::andOp(Ops::andOp(o0, o1), Ops::andOp(e2, o34)));
+	four = Ops::orOp(four, Ops::andOp(Ops::andOp(o0, o12), Ops::andOp(e3, o4)));
+	four = Ops::orOp(four, Ops::andOp(Ops::andOp(o0, o12), Ops::andOp(o3, e4)));
+	// The two windows of an open four are reported as the open four
+	four = Ops::andNot(Ops::orOp(openFour, Ops::template shl<1>(openFour)), four);
+
+	// ..OOO. and .OOO..; "..OOO.." matches both, one square apart
+	const Vec e05 = Ops::andOp(e0, e5);
+	const Vec threeLeft = Ops::andOp(Ops::andOp(e05, e1), Ops::andOp(o2, o34));
+	const Vec threeRight = Ops::andOp(Ops::andOp(e05, e4), Ops::andOp(o12, o3));
+	const Vec openThree = Ops::orOp(threeLeft,
+		Ops::andNot(Ops::template shl<1>(threeLeft), threeRight));
+
+	// .O.OO. and .OO.O.
+	const Vec brokenThree = Ops::andOp(Ops::andOp(e05, o1),
+		Ops::orOp(Ops::andOp(e2, o34),
+			  Ops::andOp(Ops::andOp(o2, e3), o4)));
+
+	Ops::store(out[Chess::GomokuPatterns::Five] + i, five);
+	Ops::store(out[Chess::GomokuPatterns::OpenFour] + i, openFour);
+	Ops::store(out[Chess::GomokuPatterns::Four] + i, four);
+	Ops::store(out[Chess::GomokuPatterns::OpenThree] + i, openThree);
+	Ops::store(out[Chess::GomokuPatterns::BrokenThree] + i, brokenThree);
+}
+
+template <typename Ops>
+void classifyLines(const quint32* own,
+		   const quint32* opponent,
+		   const quint32* mask,
+		   int count,
+		   quint32* const out[PatternCount])
+{
+	for (int i = 0; i < count; i += Ops::Width)
+		classifyBlock<Ops>(own, opponent, mask, i, out);
+}
+
+} // anonymous namespace
+
+namespace Chess {
+namespace GomokuPatterns {
+
+void classify(const quint32* own,
+	      const quint32* opponent,
+	      const quint32* mask,
+	      int count,
+	      quint32* const out[PatternCount])
+{
+	classifyLines<SimdOps>(own, opponent, mask, count, out);
+}
+
+void classifyScalar(const quint32* own,
+		    const quint32* opponent,
+		    const quint32* mask,
+		    int count,
+		    quint32* const out[PatternCount])
+{
+	classifyLines<ScalarOps>(own, opponent, mask, count, out);
+}
+
+const char* instructionSet()
+{
+#if defined(__AVX2__)
+	return "AVX2";
+#elif defined(GOMOKUPATTERNS_SSE2)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+} // namespace GomokuPatterns
+} // namespace Chess
@@ -0,0 +1,100 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GOMOKUPATTERNS_H
+#define GOMOKUPATTERNS_H
+
+#include <QtGlobal>
+
+namespace Chess {
+
+/*!
+ * \brief Line pattern classification for gomoku boards
+ *
+ * The kernel takes a batch of board lines, each encoded as a 32-bit
+ * mask of the player's stones, the opponent's stones and the squares
+ * that exist on the board, and finds the following patterns in every
+ * line (O = own stone, . = empty square):
+ *
+ * - Five: OOOOO
+ * - OpenFour: .OOOO.
+ * - Four: a five-square window with four own stones and one empty
+ *   square, eg. OO.OO, that is not part of an open four
+ * - OpenThree: ..OOO. or .OOO..
+ * - BrokenThree: .O.OO. or .OO.O.
+ *
+ * Opponent stones and the edges of the board block a pattern.
+ *
+ * The result for each pattern is a mask per line with a bit set on the
+ * first square of every match, including the empty squares that belong
+ * to the pattern. The same shift/AND expressions are evaluated on
+ * several lines at once with AVX2 or SSE2 when the compiler targets
+ * them, and on one line at a time otherwise.
+ */
+namespace GomokuPatterns {
+
+/*! The line patterns found by the kernel. */
+enum Pattern
+{
+	Five,		//!< Five or more stones in a row
+	OpenFour,	//!< Four in a row with empty squares at both ends
+	Four,		//!< Four stones that can become a five in one move
+	OpenThree,	//!< Three in a row that can become an open four
+	BrokenThree,	//!< A split three that can become an open four
+	PatternCount
+};
+
+/*!
+ * The number of lines processed in one block.
+ *
+ * The input and output arrays passed to classify() must have room for
+ * \a count rounded up to a multiple of BlockSize elements.
+ */
+const int BlockSize = 8;
+
+/*!
+ * Classifies \a count lines.
+ *
+ * \param own The stones of the player, one mask per line.
+ * \param opponent The stones of the opponent.
+ * \param mask The squares of each line that are on the board.
+ * \param out One array for each Pattern that receives the matches.
+ */
+LIB_EXPORT void classify(const quint32* own,
+			 const quint32* opponent,
+			 const quint32* mask,
+			 int count,
+			 quint32* const out[PatternCount]);
+
+/*!
+ * Same as classify(), but always evaluates one line at a time.
+ *
+ * This is the reference implementation for the vectorized kernel.
+ */
+LIB_EXPORT void classifyScalar(const quint32* own,
+			       const quint32* opponent,
+			       const quint32* mask,
+			       int count,
+			       quint32* const out[PatternCount]);
+
+/*! Returns the name of the instruction set used by classify(). */
+LIB_EXPORT const char* instructionSet();
+
+} // namespace GomokuPatterns
+} // namespace Chess
+#endif // GOMOKUPATTERNS_H
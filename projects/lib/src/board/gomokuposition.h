@@ -0,0 +1,69 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GOMOKUPOSITION_H
+#define GOMOKUPOSITION_H
+
+#include <QtGlobal>
+#include <QTypeInfo>
+#include "move.h"
+
+namespace Chess {
+
+/*!
+ * \brief A compact snapshot of a gomoku position
+ *
+ * GomokuPosition holds only what is needed to restore a position:
+ * the stones of both sides, the side to move, the ply and the
+ * zobrist key. It is a plain struct of about a kilobyte, so it can
+ * be copied with memcpy, stored in arrays and passed between threads
+ * freely.
+ *
+ * A snapshot is taken with GomokuBoard::position() and restored with
+ * GomokuBoard::setPosition(). The move history is not part of the
+ * snapshot. Every board size that GomokuBoard supports fits in a
+ * snapshot.
+ */
+struct GomokuPosition
+{
+	/*! The number of 64-bit words per side. */
+	static const int WordCount = (Move::MaxSquare + 1) / 64;
+
+	/*!
+	 * The stones of each side (indexed by Side::Type) as a bitset
+	 * of square indexes: bit \a n of the set is the square on
+	 * file n % width and rank n / width.
+	 */
+	quint64 stones[2][WordCount];
+	/*! The zobrist key of the position. */
+	quint64 key;
+	/*! The number of half-moves played to reach the position. */
+	quint16 ply;
+	/*! The width of the board. */
+	quint16 width;
+	/*! The height of the board. */
+	quint16 height;
+	/*! The side to move (a Side::Type value). */
+	quint8 sideToMove;
+};
+
+} // namespace Chess
+
+Q_DECLARE_TYPEINFO(Chess::GomokuPosition, Q_PRIMITIVE_TYPE);
+
+#endif // GOMOKUPOSITION_H
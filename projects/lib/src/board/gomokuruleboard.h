@@ -0,0 +1,185 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GOMOKURULEBOARD_H
+#define GOMOKURULEBOARD_H
+
+#include "gomokuboard.h"
+
+namespace Chess {
+
+/*!
+ * \brief Winning rule of standard gomoku
+ *
+ * Only exactly five stones in a row win; overlines don't.
+ */
+struct StandardGomokuRule
+{
+	static QString variant() { return "gomoku-standard"; }
+	static bool isWin(Side side, int length, int blockedEnds)
+	{
+		Q_UNUSED(side);
+		Q_UNUSED(blockedEnds);
+		return length == 5;
+	}
+};
+
+/*!
+ * \brief Winning rule of Caro
+ *
+ * Five or more stones in a row win unless the row is blocked by
+ * opponent stones at both ends. The edge of the board doesn't
+ * block a row.
+ */
+struct CaroRule
+{
+	static QString variant() { return "caro"; }
+	static bool isWin(Side side, int length, int blockedEnds)
+	{
+		Q_UNUSED(side);
+		return length >= 5 && blockedEnds < 2;
+	}
+};
+
+/*!
+ * \brief A gomoku board with a custom winning rule
+ *
+ * The rule is a policy class with two static functions:
+ * - \c variant() returns the name of the variant
+ * - \c isWin(side, length, blockedEnds) returns true if a row of
+ *   \c length stones of \c side wins when \c blockedEnds (0-2) of
+ *   its ends are next to an opponent stone
+ *
+ * The rule is called inline from the scan of the lines through the
+ * last stone, so there is no virtual call per square or direction.
+ * Freestyle gomoku (five or more) is GomokuBoard itself.
+ */
+template<class Rule>
+class GomokuRuleBoard : public GomokuBoard
+{
+	public:
+		// Inherited from GomokuBoard
+		virtual Board* copy() const;
+		virtual QString variant() const;
+		virtual Result result();
+
+	protected:
+		/*!
+		 * Returns true if the stone on \a square is part of a
+		 * winning row.
+		 */
+		bool isWinningStone(const Square& square) const;
+};
+
+/*! \brief A board for standard gomoku (exactly five wins) */
+typedef GomokuRuleBoard<StandardGomokuRule> StandardGomokuBoard;
+/*! \brief A board for Caro (a row blocked at both ends doesn't win) */
+typedef GomokuRuleBoard<CaroRule> CaroBoard;
+
+
+template<class Rule>
+Board* GomokuRuleBoard<Rule>::copy() const
+{
+	return new GomokuRuleBoard<Rule>(*this);
+}
+
+template<class Rule>
+QString GomokuRuleBoard<Rule>::variant() const
+{
+	return Rule::variant();
+}
+
+template<class Rule>
+Result GomokuRuleBoard<Rule>::result()
+{
+	if (m_resultPly == plyCount())
+		return m_result;
+
+	m_result = Result();
+	m_resultPly = plyCount();
+
+	Side winner;
+	if (!m_moveHistory.isEmpty()) {
+		const Square lastSq = chessSquare(lastMove().targetSquare());
+		if (isWinningStone(lastSq))
+			winner = pieceAt(lastSq).side();
+	} else if (m_plyOffset > 0) {
+		// Every row of five or more starts a five pattern
+		const auto fives = findFiveConnections();
+		for (const FiveConnectionInfo& five : fives) {
+			if (isWinningStone(five.startSq)) {
+				winner = five.color;
+				break;
+			}
+		}
+	}
+	if (!winner.isNull()) {
+		QString str = tr("%1 wins by five connections").arg(winner.toString());
+		m_result = Result(Result::Win, winner, str);
+		return m_result;
+	}
+
+	// Draw: Board is full
+	if (m_emptySquares.isEmpty())
+		m_result = Result(Result::Draw, Side::NoSide, "Wokelipangdiu");
+
+	return m_result;
+}
+
+template<class Rule>
+bool GomokuRuleBoard<Rule>::isWinningStone(const Square& square) const
+{
+	static const int steps[GomokuBitboard::DirectionCount][2] = {
+		{ 1, 0 }, { 0, 1 }, { 1, 1 }, { 1, -1 }
+	};
+
+	const Side side = m_bitboard.sideAt(square.file(), square.rank());
+	if (side.isNull())
+		return false;
+
+	for (int dir = 0; dir < GomokuBitboard::DirectionCount; dir++) {
+		const int length = m_bitboard.connectionLength(
+			side, GomokuBitboard::Direction(dir),
+			square.file(), square.rank());
+		if (length < 5)
+			continue;
+
+		// Look at the squares just beyond both ends of the row
+		int blockedEnds = 0;
+		for (int sign = -1; sign <= 1; sign += 2) {
+			int f = square.file() + sign * steps[dir][0];
+			int r = square.rank() + sign * steps[dir][1];
+			while (f >= 0 && f < m_width && r >= 0 && r < m_height
+			    && m_bitboard.hasStone(side, f, r)) {
+				f += sign * steps[dir][0];
+				r += sign * steps[dir][1];
+			}
+			if (f >= 0 && f < m_width && r >= 0 && r < m_height
+			&&  m_bitboard.hasStone(side.opposite(), f, r))
+				blockedEnds++;
+		}
+
+		if (Rule::isWin(side, length, blockedEnds))
+			return true;
+	}
+
+	return false;
+}
+
+} // namespace Chess
+#endif // GOMOKURULEBOARD_H
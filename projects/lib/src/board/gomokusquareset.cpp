@@ -0,0 +1,72 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gomokusquareset.h"
+
+namespace Chess {
+
+GomokuSquareSet::GomokuSquareSet()
+	: m_count(0)
+{
+}
+
+void GomokuSquareSet::fill(int capacity)
+{
+	Q_ASSERT(capacity >= 0 && capacity <= 0x10000);
+
+	m_squares.resize(capacity);
+	m_positions.resize(capacity);
+	for (int i = 0; i < capacity; i++)
+	{
+		m_squares[i] = quint16(i);
+		m_positions[i] = quint16(i);
+	}
+	m_count = capacity;
+}
+
+void GomokuSquareSet::insert(int square)
+{
+	Q_ASSERT(square >= 0 && square < capacity());
+	Q_ASSERT(!contains(square));
+
+	swap(m_positions.at(square), m_count);
+	m_count++;
+}
+
+void GomokuSquareSet::remove(int square)
+{
+	Q_ASSERT(contains(square));
+
+	m_count--;
+	swap(m_positions.at(square), m_count);
+}
+
+void GomokuSquareSet::swap(int i, int j)
+{
+	if (i == j)
+		return;
+
+	const quint16 a = m_squares.at(i);
+	const quint16 b = m_squares.at(j);
+	m_squares[i] = b;
+	m_squares[j] = a;
+	m_positions[a] = quint16(j);
+	m_positions[b] = quint16(i);
+}
+
+} // namespace Chess
@@ -0,0 +1,106 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GOMOKUSQUARESET_H
+#define GOMOKUSQUARESET_H
+
+#include <QVector>
+
+namespace Chess {
+
+/*!
+ * \brief A set of square indexes with O(1) insertion, removal and lookup
+ *
+ * The set is a permutation of the squares 0 .. capacity() - 1 where
+ * the first count() entries are the members, plus the position of
+ * every square in that permutation. Inserting or removing a square
+ * swaps it across the boundary, so the members can be iterated
+ * without scanning the non-members.
+ *
+ * The iteration order depends on the order of the insertions and
+ * removals, not only on the members.
+ */
+class LIB_EXPORT GomokuSquareSet
+{
+	public:
+		/*! Creates a new empty set with no capacity. */
+		GomokuSquareSet();
+
+		/*!
+		 * Resizes the set to \a capacity squares and makes every
+		 * square a member.
+		 */
+		void fill(int capacity);
+
+		/*! Returns the number of squares the set can hold. */
+		int capacity() const;
+		/*! Returns the number of squares in the set. */
+		int count() const;
+		/*! Returns true if the set is empty. */
+		bool isEmpty() const;
+		/*! Returns the member at position \a i. */
+		int at(int i) const;
+		/*!
+		 * Returns true if \a square is in the set.
+		 * Squares outside the capacity are never members.
+		 */
+		bool contains(int square) const;
+
+		/*! Adds \a square to the set. */
+		void insert(int square);
+		/*! Removes \a square from the set. */
+		void remove(int square);
+
+	private:
+		void swap(int i, int j);
+
+		int m_count;
+		QVector<quint16> m_squares;
+		QVector<quint16> m_positions;
+};
+
+inline int GomokuSquareSet::capacity() const
+{
+	return m_squares.size();
+}
+
+inline int GomokuSquareSet::count() const
+{
+	return m_count;
+}
+
+inline bool GomokuSquareSet::isEmpty() const
+{
+	return m_count == 0;
+}
+
+inline int GomokuSquareSet::at(int i) const
+{
+	Q_ASSERT(i >= 0 && i < m_count);
+	return m_squares.at(i);
+}
+
+inline bool GomokuSquareSet::contains(int square) const
+{
+	return square >= 0
+	    && square < m_positions.size()
+	    && m_positions.at(square) < m_count;
+}
+
+} // namespace Chess
+#endif // GOMOKUSQUARESET_H
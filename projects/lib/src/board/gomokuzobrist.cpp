@@ -0,0 +1,55 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gomokuzobrist.h"
+#include <QMutexLocker>
+#include "piece.h"
+
+
+namespace Chess {
+
+GomokuZobrist::GomokuZobrist(const quint64* keys)
+	: Zobrist(keys)
+{
+}
+
+void GomokuZobrist::initialize(int squareCount,
+			       int pieceTypeCount)
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (isInitialized())
+		return;
+
+	Zobrist::initialize(squareCount, pieceTypeCount);
+}
+
+quint64 GomokuZobrist::side() const
+{
+	return keys()[0];
+}
+
+quint64 GomokuZobrist::piece(const Piece& piece, int square) const
+{
+	Q_ASSERT(piece.isValid());
+	Q_ASSERT(square >= 0 && square < squareCount());
+
+	return keys()[1 + squareCount() * piece.side() + square];
+}
+
+} // namespace Chess
@@ -0,0 +1,56 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GOMOKUZOBRIST_H
+#define GOMOKUZOBRIST_H
+
+#include "zobrist.h"
+#include <QMutex>
+
+namespace Chess {
+
+/*!
+ * \brief Zobrist keys for gomoku variants
+ *
+ * Gomoku has only one piece type (a stone), so unlike the generic
+ * Zobrist class only one key per side and square is reserved.
+ */
+class LIB_EXPORT GomokuZobrist : public Zobrist
+{
+	public:
+		/*!
+		 * Creates a new uninitialized GomokuZobrist object.
+		 *
+		 * \param keys An array of zobrist keys that can be used
+		 * instead of the random numbers generated by the Zobrist
+		 * class.
+		 */
+		GomokuZobrist(const quint64* keys = nullptr);
+
+		// Inherited from Zobrist
+		virtual void initialize(int squareCount,
+					int pieceTypeCount);
+		virtual quint64 side() const;
+		virtual quint64 piece(const Piece& piece, int square) const;
+
+	private:
+		QMutex m_mutex;
+};
+
+} //namespace Chess
+#endif // GOMOKUZOBRIST_H
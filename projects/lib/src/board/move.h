@@ -34,6 +34,8 @@ namespace Chess {
  * The source and target squares have an integer format specific to a
  * certain type of chess variant. The Board class has methods for
  * converting between these integers and the generic Square type.
+ * Square indexes can be at most MaxSquare, and promotion types at
+ * most MaxPromotion.
  *
  * \sa Piece
  * \sa Board
@@ -42,6 +44,11 @@ namespace Chess {
 class Move
 {
 	public:
+		/*! The largest square index that fits in a move. */
+		static const int MaxSquare = 0xFFF;
+		/*! The largest promotion type that fits in a move. */
+		static const int MaxPromotion = 0xFF;
+
 		/*! Creates an empty Move (null move). */
 		Move();
 		/*!
@@ -91,12 +98,12 @@ inline Move::Move(int sourceSquare,
 		  int targetSquare,
 		  int promotion)
 	: m_data(sourceSquare |
-		 (targetSquare << 10) |
-		 (promotion << 20))
+		 (targetSquare << 12) |
+		 (quint32(promotion) << 24))
 {
-	Q_ASSERT(sourceSquare >= 0 && sourceSquare <= 0x3FF);
-	Q_ASSERT(targetSquare >= 0 && targetSquare <= 0x3FF);
-	Q_ASSERT(promotion >= 0 && promotion <= 0x3FF);
+	Q_ASSERT(sourceSquare >= 0 && sourceSquare <= MaxSquare);
+	Q_ASSERT(targetSquare >= 0 && targetSquare <= MaxSquare);
+	Q_ASSERT(promotion >= 0 && promotion <= MaxPromotion);
 }
 
 inline bool Move::isNull() const
@@ -116,17 +123,17 @@ inline bool Move::operator!=(const Move& other) const
 
 inline int Move::sourceSquare() const
 {
-	return m_data & 0x3FF;
+	return m_data & MaxSquare;
 }
 
 inline int Move::targetSquare() const
 {
-	return (m_data >> 10) & 0x3FF;
+	return (m_data >> 12) & MaxSquare;
 }
 
 inline int Move::promotion() const
 {
-	return (m_data >> 20) & 0x3FF;
+	return (m_data >> 24) & MaxPromotion;
 }
 
 } // namespace Chess
@@ -0,0 +1,276 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "renjuboard.h"
+
+namespace {
+
+// Steps along the lines of each GomokuBitboard::Direction
+const int s_lineOffsets[Chess::GomokuBitboard::DirectionCount][2] = {
+	{ 1, 0 }, { 0, 1 }, { 1, 1 }, { 1, -1 }
+};
+
+// A line window covers the squares at most WindowRadius steps away
+// from its center, which is enough to tell a five from an overline.
+const int WindowRadius = 5;
+const int WindowSize = 2 * WindowRadius + 1;
+
+// Deeper threes are assumed to be real
+const int MaxDepth = 6;
+
+inline bool testBit(quint32 bits, int i)
+{
+	return (bits >> i) & 1;
+}
+
+// Finds the run of stones going through the center of a window
+void centerRun(quint32 stones, int* first, int* last)
+{
+	*first = WindowRadius;
+	while (*first > 0 && testBit(stones, *first - 1))
+		--*first;
+	*last = WindowRadius;
+	while (*last < WindowSize - 1 && testBit(stones, *last + 1))
+		++*last;
+}
+
+} // anonymous namespace
+
+namespace Chess {
+
+RenjuBoard::RenjuBoard()
+	: GomokuRuleBoard<RenjuRule>()
+{
+	// GomokuBoard's constructor can't call our reset()
+	reset();
+}
+
+Board* RenjuBoard::copy() const
+{
+	return new RenjuBoard(*this);
+}
+
+void RenjuBoard::reset()
+{
+	GomokuRuleBoard<RenjuRule>::reset();
+
+	const int squares = m_width * m_height;
+	m_linePatterns.fill(0, squares * GomokuBitboard::DirectionCount);
+	m_verdicts.fill(Unknown, squares);
+}
+
+Result RenjuBoard::result()
+{
+	if (m_resultPly == plyCount())
+		return m_result;
+
+	GomokuRuleBoard<RenjuRule>::result();
+	if (!m_result.isNone() || m_side != Side::Black)
+		return m_result;
+
+	// Draw: every empty square is forbidden
+	const int count = m_emptySquares.count();
+	for (int i = 0; i < count; i++) {
+		if (!isForbidden(m_emptySquares.at(i), 0))
+			return m_result;
+	}
+	m_result = Result(Result::Draw, Side::NoSide,
+			  tr("Black has no allowed moves"));
+
+	return m_result;
+}
+
+bool RenjuBoard::isForbidden(const Square& square)
+{
+	const int sq = squareIndex(square);
+	Q_ASSERT(m_emptySquares.contains(sq));
+
+	return isForbidden(sq, 0);
+}
+
+bool RenjuBoard::vIsLegalMove(const Move& move)
+{
+	if (!GomokuRuleBoard<RenjuRule>::vIsLegalMove(move))
+		return false;
+	return m_side != Side::Black || !isForbidden(move.targetSquare(), 0);
+}
+
+void RenjuBoard::setSquare(int square, Piece piece)
+{
+	GomokuRuleBoard<RenjuRule>::setSquare(square, piece);
+	invalidateLines(square);
+
+	// A stone anywhere can change a recursive 3-3 verdict
+	m_verdicts.fill(Unknown);
+}
+
+bool RenjuBoard::isForbidden(int square, int depth)
+{
+	if (depth == 0 && m_verdicts[square] != Unknown)
+		return m_verdicts[square] == Forbidden;
+
+	quint16 patterns[GomokuBitboard::DirectionCount];
+	for (int dir = 0; dir < GomokuBitboard::DirectionCount; dir++) {
+		patterns[dir] = linePattern(square, dir);
+
+		// A five wins even if the move is otherwise forbidden
+		if (patterns[dir] & FiveBit) {
+			if (depth == 0)
+				m_verdicts[square] = Allowed;
+			return false;
+		}
+	}
+
+	int fours = 0;
+	int threes = 0;
+	bool overline = false;
+	for (int dir = 0; dir < GomokuBitboard::DirectionCount; dir++) {
+		overline |= (patterns[dir] & OverlineBit) != 0;
+		fours += (patterns[dir] & FourMask) >> FourShift;
+		if (patterns[dir] & ThreeMask)
+			threes++;
+	}
+
+	bool forbidden = overline || fours >= 2;
+	if (!forbidden && threes >= 2 && depth < MaxDepth) {
+		// Only count the threes that have an allowed move to a
+		// straight four
+		const int file = square % m_width;
+		const int rank = square / m_width;
+		threes = 0;
+
+		setTemporaryStone(square, true);
+		for (int dir = 0; dir < GomokuBitboard::DirectionCount && threes < 2; dir++) {
+			quint32 targets = patterns[dir] & ThreeMask;
+			while (targets) {
+				const int k = GomokuBitboard::lowestBit(targets) - WindowRadius;
+				targets &= targets - 1;
+
+				const int f = file + k * s_lineOffsets[dir][0];
+				const int r = rank + k * s_lineOffsets[dir][1];
+				if (!isForbidden(r * m_width + f, depth + 1)) {
+					threes++;
+					break;
+				}
+			}
+		}
+		setTemporaryStone(square, false);
+	}
+	forbidden |= threes >= 2;
+
+	if (depth == 0)
+		m_verdicts[square] = forbidden ? Forbidden : Allowed;
+	return forbidden;
+}
+
+quint16 RenjuBoard::linePattern(int square, int dir)
+{
+	quint16& pattern = m_linePatterns[square * GomokuBitboard::DirectionCount + dir];
+	if (pattern & ValidBit)
+		return pattern;
+
+	// Read the window. Squares that are off the board or have a
+	// white stone are neither stones nor empty.
+	const int file = square % m_width;
+	const int rank = square / m_width;
+	quint32 stones = 1 << WindowRadius;
+	quint32 empty = 0;
+	for (int k = -WindowRadius; k <= WindowRadius; k++) {
+		const int f = file + k * s_lineOffsets[dir][0];
+		const int r = rank + k * s_lineOffsets[dir][1];
+		if (k == 0 || f < 0 || f >= m_width || r < 0 || r >= m_height)
+			continue;
+
+		const Side side = m_bitboard.sideAt(f, r);
+		if (side == Side::Black)
+			stones |= 1 << (k + WindowRadius);
+		else if (side.isNull())
+			empty |= 1 << (k + WindowRadius);
+	}
+
+	int first;
+	int last;
+	centerRun(stones, &first, &last);
+	pattern = ValidBit;
+	if (last - first == 4)
+		return pattern |= FiveBit;
+	if (last - first > 4)
+		return pattern |= OverlineBit;
+
+	// Try every empty square that could join the center run
+	int fours = 0;
+	int fourSquare = -1;
+	quint16 threes = 0;
+	for (int i = 1; i < WindowSize - 1; i++) {
+		if (!testBit(empty, i))
+			continue;
+
+		centerRun(stones | (1 << i), &first, &last);
+		if (i < first || i > last)
+			continue;
+
+		if (last - first == 4) {
+			// The two ends of a straight four are the same four
+			if (fours == 0 || i - fourSquare != 5)
+				fours++;
+			fourSquare = i;
+		} else if (last - first == 3
+			&& testBit(empty, first - 1) && testBit(empty, last + 1)
+			&& !testBit(stones, first - 2) && !testBit(stones, last + 2)) {
+			threes |= 1 << i;
+		}
+	}
+
+	// A four hides a three on the same line
+	if (fours > 0)
+		pattern |= qMin(fours, 2) << FourShift;
+	else
+		pattern |= threes;
+
+	return pattern;
+}
+
+void RenjuBoard::setTemporaryStone(int square, bool place)
+{
+	const int file = square % m_width;
+	const int rank = square / m_width;
+
+	if (place)
+		m_bitboard.setStone(Side::Black, file, rank);
+	else
+		m_bitboard.clearStone(Side::Black, file, rank);
+	invalidateLines(square);
+}
+
+void RenjuBoard::invalidateLines(int square)
+{
+	const int file = square % m_width;
+	const int rank = square / m_width;
+
+	for (int dir = 0; dir < GomokuBitboard::DirectionCount; dir++) {
+		for (int k = -WindowRadius; k <= WindowRadius; k++) {
+			const int f = file + k * s_lineOffsets[dir][0];
+			const int r = rank + k * s_lineOffsets[dir][1];
+			if (f < 0 || f >= m_width || r < 0 || r >= m_height)
+				continue;
+			m_linePatterns[(r * m_width + f) * GomokuBitboard::DirectionCount + dir] = 0;
+		}
+	}
+}
+
+} // namespace Chess
@@ -0,0 +1,119 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RENJUBOARD_H
+#define RENJUBOARD_H
+
+#include "gomokuruleboard.h"
+
+namespace Chess {
+
+/*!
+ * \brief Winning rule of Renju
+ *
+ * White wins with five or more stones in a row, Black only with
+ * exactly five.
+ */
+struct RenjuRule
+{
+	static QString variant() { return "renju"; }
+	static bool isWin(Side side, int length, int blockedEnds)
+	{
+		Q_UNUSED(blockedEnds);
+		return side == Side::Black ? length == 5 : length >= 5;
+	}
+};
+
+/*!
+ * \brief A board for Renju
+ *
+ * Renju is gomoku with restrictions on the first player (Black).
+ * The winning rule is RenjuRule. Unless it makes a five, a black
+ * move is forbidden (and therefore illegal) if it makes an overline
+ * (six or more in a row), two fours or two threes.
+ *
+ * A three only counts if it can become a straight four with a move
+ * that isn't forbidden itself, so the 3-3 rule is recursive. To
+ * keep move validation cheap the board caches the line pattern that
+ * a black stone would make on each empty square in each direction.
+ * A stone only changes the patterns of the squares at most five
+ * steps away on its four lines, so the cache is updated
+ * incrementally.
+ *
+ * \note The rules are those of the Renju International Federation.
+ */
+class LIB_EXPORT RenjuBoard : public GomokuRuleBoard<RenjuRule>
+{
+	public:
+		/*! Creates a new RenjuBoard object. */
+		RenjuBoard();
+
+		// Inherited from GomokuRuleBoard
+		virtual Board* copy() const;
+		virtual void reset();
+		virtual Result result();
+
+		/*!
+		 * Returns true if a black stone on the empty square
+		 * \a square would be a forbidden move.
+		 *
+		 * The result doesn't depend on the side to move.
+		 */
+		bool isForbidden(const Square& square);
+
+	protected:
+		// Inherited from GomokuRuleBoard
+		virtual bool vIsLegalMove(const Move& move);
+		virtual void setSquare(int square, Piece piece);
+
+	private:
+		/*!
+		 * Bit layout of a cached line pattern: the pattern that a
+		 * black stone in the center of an 11-square window would
+		 * make with the other stones in the window.
+		 */
+		enum LinePattern
+		{
+			/*! Squares that turn the pattern into a straight four. */
+			ThreeMask = 0x7ff,
+			FourShift = 11,
+			/*! Number of fours (0-2). */
+			FourMask = 3 << FourShift,
+			FiveBit = 1 << 13,
+			OverlineBit = 1 << 14,
+			/*! The cache entry is up to date. */
+			ValidBit = 1 << 15
+		};
+		enum Verdict
+		{
+			Unknown,
+			Allowed,
+			Forbidden
+		};
+
+		bool isForbidden(int square, int depth);
+		quint16 linePattern(int square, int dir);
+		void setTemporaryStone(int square, bool place);
+		void invalidateLines(int square);
+
+		QVector<quint16> m_linePatterns;
+		QVector<quint8> m_verdicts;
+};
+
+} // namespace Chess
+#endif // RENJUBOARD_H
@@ -24,7 +24,7 @@
 
 namespace {
 
-QVarLengthArray<quint64, 0x2000> s_keys;
+QVarLengthArray<quint64, 0x4000> s_keys;
 QMutex s_mutex;
 
 } // anonymous namespace
@@ -18,10 +18,14 @@
 
 #include "chessengine.h"
 #include <QIODevice>
+#include <QProcess>
+#include <QMetaMethod>
 #include <QTimer>
 #include <QStringRef>
 #include <QtAlgorithms>
+#include <cstring>
 #include "engineoption.h"
+#include "cpuaffinity.h"
 
 
 int ChessEngine::s_count = 0;
@@ -76,13 +80,23 @@ ChessEngine::ChessEngine(QObject* parent)
 	  m_pinging(false),
 	  m_whiteEvalPov(false),
 	  m_pondering(false),
+	  m_failedToStart(false),
 	  m_pingTimer(new QTimer(this)),
 	  m_quitTimer(new QTimer(this)),
 	  m_idleTimer(new QTimer(this)),
 	  m_protocolStartTimer(new QTimer(this)),
 	  m_ioDevice(nullptr),
+	  m_writeBatchDepth(0),
+	  m_reading(false),
+	  m_outputRateLimit(0),
+	  m_outputLineCount(0),
+	  m_droppedLineCount(0),
 	  m_restartMode(EngineConfiguration::RestartAuto)
 {
+	// Reserved capacity isn't released when the buffers are emptied
+	m_writeData.reserve(1024);
+	m_readBuffer.reserve(4096);
+
 	m_pingTimer->setSingleShot(true);
 	m_pingTimer->setInterval(15000);
 	connect(m_pingTimer, SIGNAL(timeout()), this, SLOT(onPingTimeout()));
@@ -215,7 +229,19 @@ void ChessEngine::start()
 {
 	if (state() != NotStarted)
 		return;
-	
+
+	// Don't block the thread while the process is starting.
+	// Everything written until then goes to the write buffer.
+	auto process = qobject_cast<QProcess*>(m_ioDevice);
+	if (process != nullptr && process->state() == QProcess::Starting)
+	{
+		connect(process, SIGNAL(started()),
+			this, SLOT(start()), Qt::UniqueConnection);
+		connect(process, SIGNAL(errorOccurred(QProcess::ProcessError)),
+			this, SLOT(onProcessError()), Qt::UniqueConnection);
+		return;
+	}
+
 	m_pinging = false;
 	setState(Starting);
 
@@ -432,42 +458,193 @@ void ChessEngine::write(const QString& data, WriteMode mode)
 	}
 
 	Q_ASSERT(m_ioDevice->isWritable());
-	emit debugMessage(QString(">%1(%2): %3")
-			  .arg(name())
-			  .arg(m_id)
-			  .arg(data));
+	if (hasDebugReceivers())
+		emit debugMessage(QString(">%1(%2): %3")
+				  .arg(name())
+				  .arg(m_id)
+				  .arg(data));
+
+	// Encode the line in place. The buffer keeps its capacity, so
+	// this doesn't allocate once it has grown to the longest batch.
+	const int size = data.size();
+	const int pos = m_writeData.size();
+	m_writeData.resize(pos + size + 1);
+
+	const QChar* src = data.constData();
+	char* dst = m_writeData.data() + pos;
+	for (int i = 0; i < size; i++)
+	{
+		const ushort c = src[i].unicode();
+		dst[i] = c < 0x100 ? char(c) : '?';
+	}
+	dst[size] = '\n';
+
+	if (m_writeBatchDepth == 0)
+		sendWriteData();
+}
 
-	if (m_ioDevice->write(data.toLatin1() + "\n") == -1)
+void ChessEngine::beginWriteBatch()
+{
+	m_writeBatchDepth++;
+}
+
+void ChessEngine::endWriteBatch()
+{
+	Q_ASSERT(m_writeBatchDepth > 0);
+	if (--m_writeBatchDepth == 0)
+		sendWriteData();
+}
+
+bool ChessEngine::failedToStart() const
+{
+	return m_failedToStart;
+}
+
+bool ChessEngine::setCpuAffinity(const QList<int>& cpus)
+{
+	// On Windows the device is an EngineProcess, not a QProcess
+	auto process = qobject_cast<QProcess*>(m_ioDevice);
+	if (process == nullptr || process->state() != QProcess::Running)
+		return false;
+
+	return CpuAffinity::setProcessAffinity(process->processId(), cpus);
+}
+
+void ChessEngine::sendWriteData()
+{
+	if (m_writeData.isEmpty())
+		return;
+
+	if (state() != Disconnected
+	&&  m_ioDevice->write(m_writeData) == -1)
 		qWarning("Writing to engine %s(%d) failed",
 			 qUtf8Printable(name()), m_id);
+	m_writeData.resize(0);
 }
 
 void ChessEngine::onReadyRead()
 {
-	while (m_ioDevice->isReadable() && m_ioDevice->canReadLine())
+	// The lines are parsed in place, so the read buffer can't grow
+	// while a line is being parsed. A nested call leaves the new
+	// data to the loop below.
+	if (m_reading)
+		return;
+	m_reading = true;
+
+	while (m_ioDevice->isReadable() && m_ioDevice->bytesAvailable() > 0)
 	{
-		QString line = QString(m_ioDevice->readLine());
-		if (line.endsWith('\n'))
-			line.chop(1);
-		if (line.endsWith('\r'))
-			line.chop(1);
-		if (line.isEmpty())
-			continue;
+		// Read everything that is available with one call
+		const int pos = m_readBuffer.size();
+		const qint64 available = m_ioDevice->bytesAvailable();
+		m_readBuffer.resize(pos + int(available));
+		const qint64 count = m_ioDevice->read(m_readBuffer.data() + pos,
+						      available);
+		m_readBuffer.resize(pos + int(qMax(count, qint64(0))));
+		if (count <= 0)
+			break;
+
+		readLines();
+	}
+
+	m_reading = false;
+}
+
+void ChessEngine::readLines()
+{
+	const char* data = m_readBuffer.constData();
+	const int size = m_readBuffer.size();
+	int start = 0;
 
+	while (m_ioDevice->isReadable())
+	{
+		const char* newline = static_cast<const char*>(
+			memchr(data + start, '\n', size - start));
+		if (newline == nullptr)
+			break;
+
+		int end = int(newline - data);
+		const int next = end + 1;
+		if (end > start && data[end - 1] == '\r')
+			end--;
+
+		// The line shares the buffer's data
+		if (end > start)
+			handleLine(QByteArray::fromRawData(data + start, end - start));
+		start = next;
+	}
+
+	// Keep the incomplete last line for the next read
+	if (!m_ioDevice->isReadable())
+		m_readBuffer.resize(0);
+	else if (start > 0)
+		m_readBuffer.remove(0, start);
+}
+
+void ChessEngine::handleLine(const QByteArray& line)
+{
+	if (m_outputRateLimit > 0
+	&&  isOverRateLimit()
+	&&  isDroppableLine(line))
+	{
+		if (m_droppedLineCount++ == 0)
+			qWarning("Engine %s(%d) writes more than %d lines per second, "
+				 "dropping its debug output",
+				 qUtf8Printable(name()), m_id, m_outputRateLimit);
+		return;
+	}
+
+	if (hasDebugReceivers())
 		emit debugMessage(QString("<%1(%2): %3")
 				  .arg(name())
 				  .arg(m_id)
-				  .arg(line));
-		parseLine(line);
+				  .arg(QString::fromUtf8(line)));
+	parseRawLine(line);
 
-		if (m_idleTimer->isActive())
-		{
-			if (state() == Thinking && !m_pinging)
-				m_idleTimer->start();
-			else
-				m_idleTimer->stop();
-		}
+	if (m_idleTimer->isActive())
+	{
+		if (state() == Thinking && !m_pinging)
+			m_idleTimer->start();
+		else
+			m_idleTimer->stop();
+	}
+}
+
+bool ChessEngine::isOverRateLimit()
+{
+	// Lines are counted in windows of one second
+	if (!m_outputRateTimer.isValid() || m_outputRateTimer.elapsed() >= 1000)
+	{
+		m_outputRateTimer.start();
+		m_outputLineCount = 0;
 	}
+
+	return ++m_outputLineCount > m_outputRateLimit;
+}
+
+bool ChessEngine::isDroppableLine(const QByteArray& line) const
+{
+	Q_UNUSED(line);
+	return false;
+}
+
+void ChessEngine::setOutputRateLimit(int linesPerSecond)
+{
+	m_outputRateLimit = qMax(linesPerSecond, 0);
+	m_droppedLineCount = 0;
+}
+
+void ChessEngine::parseRawLine(const QByteArray& line)
+{
+	parseLine(QString::fromUtf8(line));
+}
+
+bool ChessEngine::hasDebugReceivers() const
+{
+	// Most games run without a debug log, so don't format the
+	// message for nobody
+	static const QMetaMethod signal =
+		QMetaMethod::fromSignal(&ChessPlayer::debugMessage);
+	return isSignalConnected(signal);
 }
 
 void ChessEngine::flushWriteBuffer()
@@ -475,9 +652,11 @@ void ChessEngine::flushWriteBuffer()
 	if (m_pinging || state() == NotStarted)
 		return;
 
+	beginWriteBatch();
 	for (const QString& line : qAsConst(m_writeBuffer))
 		write(line);
 	m_writeBuffer.clear();
+	endWriteBatch();
 }
 
 void ChessEngine::clearWriteBuffer()
@@ -497,6 +676,19 @@ void ChessEngine::onProtocolStartTimeout()
 	onCrashed();
 }
 
+void ChessEngine::onProcessError()
+{
+	// Errors of a running process are handled by onCrashed()
+	if (state() != NotStarted)
+		return;
+
+	m_failedToStart = true;
+	setError(tr("Cannot start engine %1: %2")
+		 .arg(name(), m_ioDevice->errorString()));
+	qWarning("%s", qUtf8Printable(errorString()));
+	kill();
+}
+
 void ChessEngine::onQuitTimeout()
 {
 	Q_ASSERT(state() != Disconnected);
@@ -21,6 +21,7 @@
 
 #include "chessplayer.h"
 #include <QVariant>
+#include <QElapsedTimer>
 #include <QStringList>
 #include "engineconfiguration.h"
 
@@ -69,12 +70,6 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 		virtual bool isReady() const;
 		virtual bool supportsVariant(const QString& variant) const;
 
-		/*!
-		 * Starts communicating with the engine.
-		 * \note The engine device must already be started.
-		 */
-		void start();
-
 		/*! Applies \a configuration to the engine. */
 		void applyConfiguration(const EngineConfiguration& configuration);
 
@@ -103,6 +98,20 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 		 * the device immediately even if the engine is being pinged.
 		 */
 		void write(const QString& data, WriteMode mode = Buffered);
+		/*!
+		 * Starts a batch of writes.
+		 *
+		 * Until the matching endWriteBatch() call, the lines given
+		 * to write() are collected and then sent to the device
+		 * with a single write. Batches can be nested.
+		 */
+		void beginWriteBatch();
+		/*!
+		 * Ends a batch of writes started with beginWriteBatch(),
+		 * and sends the collected lines if this was the outermost
+		 * batch.
+		 */
+		void endWriteBatch();
 
 		/*!
 		 * Sets an option with the name \a name to \a value.
@@ -118,7 +127,34 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 		/*! Returns a list of supported chess variants. */
 		QStringList variants() const;
 
+		/*!
+		 * Pins the engine process to \a cpus.
+		 * Returns true if successful.
+		 *
+		 * \note The engine device must be a running process.
+		 * \sa CpuAffinity::setProcessAffinity()
+		 */
+		bool setCpuAffinity(const QList<int>& cpus);
+
+		/*!
+		 * Returns true if the engine process could not be started.
+		 * The reason is given by errorString().
+		 */
+		bool failedToStart() const;
+
 	public slots:
+		/*!
+		 * Starts communicating with the engine.
+		 *
+		 * If the engine device is a process that is still
+		 * starting, this function returns immediately and the
+		 * communication starts when the process is running. If
+		 * the process fails to start, the engine disconnects.
+		 *
+		 * \note The engine device must already be started.
+		 */
+		void start();
+
 		// Inherited from ChessPlayer
 		virtual void go();
 		virtual void quit();
@@ -164,6 +200,34 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 
 		/*! Parses a line of input from the engine. */
 		virtual void parseLine(const QString& line) = 0;
+		/*!
+		 * Parses a line of input from the engine before it is
+		 * decoded. The line doesn't end with a newline.
+		 *
+		 * The default implementation decodes \a line as UTF-8 and
+		 * calls parseLine(). Protocols that parse the raw bytes
+		 * can reimplement this function to avoid the conversion.
+		 */
+		virtual void parseRawLine(const QByteArray& line);
+		/*!
+		 * Returns true if \a line is informational output (eg.
+		 * debug messages) that can be dropped when the engine
+		 * writes more than the output rate limit allows.
+		 *
+		 * The default implementation returns false.
+		 *
+		 * \sa setOutputRateLimit()
+		 */
+		virtual bool isDroppableLine(const QByteArray& line) const;
+		/*!
+		 * Sets the output rate limit to \a linesPerSecond.
+		 *
+		 * Droppable lines over the limit are neither parsed nor
+		 * sent as debug messages. 0 (the default) means no limit.
+		 *
+		 * \sa isDroppableLine()
+		 */
+		void setOutputRateLimit(int linesPerSecond);
 
 		/*!
 		 * Sends a ping command to the engine.
@@ -273,8 +337,15 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 	private slots:
 		void onQuitTimeout();
 		void onProtocolStartTimeout();
+		void onProcessError();
 
 	private:
+		bool hasDebugReceivers() const;
+		void sendWriteData();
+		void readLines();
+		void handleLine(const QByteArray& line);
+		bool isOverRateLimit();
+
 		static int s_count;
 
 		int m_id;
@@ -282,12 +353,21 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 		bool m_pinging;
 		bool m_whiteEvalPov;
 		bool m_pondering;
+		bool m_failedToStart;
 		QTimer* m_pingTimer;
 		QTimer* m_quitTimer;
 		QTimer* m_idleTimer;
 		QTimer* m_protocolStartTimer;
 		QIODevice *m_ioDevice;
 		QStringList m_writeBuffer;
+		QByteArray m_writeData;
+		int m_writeBatchDepth;
+		QByteArray m_readBuffer;
+		bool m_reading;
+		int m_outputRateLimit;
+		int m_outputLineCount;
+		int m_droppedLineCount;
+		QElapsedTimer m_outputRateTimer;
 		QStringList m_variants;
 		QList<EngineOption*> m_options;
 		QMap<QString, QVariant> m_optionBuffer;
@@ -18,6 +18,7 @@
 #include "chessgame.h"
 #include <QThread>
 #include <QTimer>
+#include <algorithm>
 #include "board/board.h"
 #include "chessplayer.h"
 #include "openingbook.h"
@@ -63,7 +64,12 @@ ChessGame::ChessGame(Chess::Board* board, PgnGame* pgn, QObject* parent)
 	  m_pgnInitialized(false),
 	  m_bookOwnership(false),
 	  m_boardShouldBeFlipped(false),
-	  m_pgn(pgn)
+	  m_pgn(pgn),
+	  m_swapOpening(NoSwapOpening),
+	  m_swapStage(SwapDone),
+	  m_swapPlayer(nullptr),
+	  m_playersSwapped(false),
+	  m_overtimeMoveCount(0)
 {
 	Q_ASSERT(pgn != nullptr);
 
@@ -260,6 +266,10 @@ void ChessGame::onMoveMade(const Chess::Move& move)
 		return;
 	}
 
+	const TimeControl* tc = sender->timeControl();
+	if (tc->lastMoveBudget() > 0 && tc->lastMoveTime() > tc->lastMoveBudget())
+		m_overtimeMoveCount++;
+
 	m_scores[m_moves.size()] = sender->evaluation().score();
 	m_moves.append(move);
 	addPgnMove(move, evalString(sender->evaluation()));
@@ -293,6 +303,131 @@ void ChessGame::onMoveMade(const Chess::Move& move)
 	}
 }
 
+void ChessGame::onSwapDecision(const QVector<Chess::Move>& stones)
+{
+	ChessPlayer* sender = qobject_cast<ChessPlayer*>(QObject::sender());
+	Q_ASSERT(sender != nullptr);
+
+	if (m_finished || sender != m_swapPlayer)
+	{
+		qWarning("Unexpected swap decision from %s",
+			 qUtf8Printable(sender->name()));
+		return;
+	}
+
+	const int count = stones.size();
+	ChessPlayer* other = (sender == m_player[0]) ? m_player[1] : m_player[0];
+	bool valid = false;
+
+	switch (m_swapStage)
+	{
+	case SwapPlaceThree:
+		if (count == 3 && addSwapStones(stones))
+		{
+			valid = true;
+			startSwapStage(SwapChooseAfterThree);
+		}
+		break;
+	case SwapChooseAfterThree:
+	case SwapChooseAfterFive:
+		// Taking black, or taking white and playing a move
+		if (count == 0)
+		{
+			valid = true;
+			finishSwapOpening(sender);
+		}
+		else if (count == 1 && addSwapStones(stones))
+		{
+			valid = true;
+			finishSwapOpening(other);
+		}
+		else if (count == 2
+		     &&  m_swapStage == SwapChooseAfterThree
+		     &&  m_swapOpening == Swap2
+		     &&  addSwapStones(stones))
+		{
+			valid = true;
+			startSwapStage(SwapChooseAfterFive);
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (!valid)
+	{
+		const Chess::Side winner =
+			(other == m_player[Chess::Side::White]) ?
+			Chess::Side::White : Chess::Side::Black;
+		m_result = Chess::Result(Chess::Result::IllegalMove, winner,
+					 tr("invalid swap opening decision"));
+		stop();
+	}
+}
+
+void ChessGame::startSwapStage(SwapStage stage)
+{
+	m_swapStage = stage;
+
+	// The first player places three stones, and the players take
+	// turns after that
+	if (stage != SwapPlaceThree)
+		m_swapPlayer = (m_swapPlayer == m_player[0]) ? m_player[1] : m_player[0];
+
+	m_swapPlayer->goSwap();
+}
+
+bool ChessGame::addSwapStones(const QVector<Chess::Move>& stones)
+{
+	for (const Chess::Move& move : stones)
+	{
+		if (move.isNull() || !m_board->isLegalMove(move))
+			return false;
+
+		m_moves.append(move);
+		addPgnMove(move, "swap");
+		m_player[0]->makeMove(move);
+		m_player[1]->makeMove(move);
+		m_board->makeMove(move);
+		emitLastMove();
+	}
+
+	return true;
+}
+
+void ChessGame::finishSwapOpening(ChessPlayer* black)
+{
+	m_swapStage = SwapDone;
+	m_swapPlayer = nullptr;
+
+	if (m_player[Chess::Side::Black] != black)
+	{
+		std::swap(m_player[0], m_player[1]);
+		std::swap(m_timeControl[0], m_timeControl[1]);
+		std::swap(m_book[0], m_book[1]);
+		std::swap(m_bookDepth[0], m_bookDepth[1]);
+		m_playersSwapped = !m_playersSwapped;
+
+		for (int i = 0; i < 2; i++)
+		{
+			const Chess::Side side = Chess::Side::Type(i);
+			m_player[side]->setSide(side);
+			m_pgn->setPlayerName(side, m_player[side]->name());
+		}
+		if (!(m_timeControl[Chess::Side::White] == m_timeControl[Chess::Side::Black]))
+		{
+			m_pgn->setTag("WhiteTimeControl", m_timeControl[Chess::Side::White].toString());
+			m_pgn->setTag("BlackTimeControl", m_timeControl[Chess::Side::Black].toString());
+		}
+	}
+
+	for (int i = 0; i < 2; i++)
+		disconnect(m_player[i], SIGNAL(swapDecisionMade(QVector<Chess::Move>)),
+			   this, SLOT(onSwapDecision(QVector<Chess::Move>)));
+	connectPlayers();
+	startTurn();
+}
+
 void ChessGame::startTurn()
 {
 	if (m_paused)
@@ -406,6 +541,22 @@ void ChessGame::setError(const QString& message)
 	m_error = message;
 }
 
+void ChessGame::setSwapOpening(SwapOpening rule)
+{
+	Q_ASSERT(!m_gameInProgress);
+	m_swapOpening = rule;
+}
+
+bool ChessGame::playersSwapped() const
+{
+	return m_playersSwapped;
+}
+
+int ChessGame::overtimeMoveCount() const
+{
+	return m_overtimeMoveCount;
+}
+
 void ChessGame::setPlayer(Chess::Side side, ChessPlayer* player)
 {
 	Q_ASSERT(!side.isNull());
@@ -757,6 +908,32 @@ void ChessGame::startGame()
 		}
 	}
 	
+	if (m_swapOpening != NoSwapOpening)
+	{
+		if (!m_moves.isEmpty() || !m_startingFen.isEmpty())
+			qWarning("The swap opening is skipped because the game "
+				 "doesn't start from an empty board");
+		else if (!m_player[0]->supportsSwapOpening()
+		     ||  !m_player[1]->supportsSwapOpening())
+			qWarning("The swap opening is skipped because a player "
+				 "doesn't support it");
+		else
+		{
+			for (int i = 0; i < 2; i++)
+				connect(m_player[i], SIGNAL(swapDecisionMade(QVector<Chess::Move>)),
+					this, SLOT(onSwapDecision(QVector<Chess::Move>)));
+			m_swapPlayer = m_player[Chess::Side::Black];
+			startSwapStage(SwapPlaceThree);
+			return;
+		}
+	}
+
+	connectPlayers();
+	startTurn();
+}
+
+void ChessGame::connectPlayers()
+{
 	for (int i = 0; i < 2; i++)
 	{
 		connect(m_player[i], SIGNAL(moveMade(Chess::Move)),
@@ -765,6 +942,4 @@ void ChessGame::startGame()
 			connect(m_player[i], SIGNAL(wokeUp()),
 				this, SLOT(resume()));
 	}
-	
-	startTurn();
 }
@@ -40,6 +40,22 @@ class LIB_EXPORT ChessGame : public QObject
 	Q_OBJECT
 
 	public:
+		/*!
+		 * Swap opening rules of gomoku.
+		 *
+		 * In both rules the first player places three stones
+		 * (two black, one white) and the second player either
+		 * takes black or takes white and plays the fourth stone.
+		 * With Swap2 the second player can also place two more
+		 * stones, after which the first player picks a color.
+		 */
+		enum SwapOpening
+		{
+			NoSwapOpening,	//!< Normal alternating moves
+			Swap1,		//!< Place 3, then choose
+			Swap2		//!< Place 3, then choose or place 2
+		};
+
 		ChessGame(Chess::Board* board, PgnGame* pgn, QObject* parent = nullptr);
 		virtual ~ChessGame();
 		
@@ -71,6 +87,21 @@ class LIB_EXPORT ChessGame : public QObject
 		void setAdjudicator(const GameAdjudicator& adjudicator);
 		void setStartDelay(int time);
 		void setBookOwnership(bool enabled);
+		void setSwapOpening(SwapOpening rule);
+		/*!
+		 * Returns true if the players exchanged sides during a
+		 * swap opening, so that the player set up with setPlayer()
+		 * as White plays Black and vice versa.
+		 */
+		bool playersSwapped() const;
+		/*!
+		 * Returns the number of moves that took longer than the
+		 * time allotted to them. Such moves don't lose on time but
+		 * are an early sign that the player is short of CPU time.
+		 *
+		 * \sa TimeControl::lastMoveBudget()
+		 */
+		int overtimeMoveCount() const;
 
 		void generateOpening();
 
@@ -85,6 +116,7 @@ class LIB_EXPORT ChessGame : public QObject
 		void kill();
 		void emitStartFailed();
 		void onMoveMade(const Chess::Move& move);
+		void onSwapDecision(const QVector<Chess::Move>& stones);
 		void onAdjudication(const Chess::Result& result);
 		void onResignation(const Chess::Result& result);
 
@@ -116,7 +148,19 @@ class LIB_EXPORT ChessGame : public QObject
 		void pauseThread();
 
 	private:
+		enum SwapStage
+		{
+			SwapDone,
+			SwapPlaceThree,
+			SwapChooseAfterThree,
+			SwapChooseAfterFive
+		};
+
 		Chess::Move bookMove(Chess::Side side);
+		void connectPlayers();
+		void startSwapStage(SwapStage stage);
+		bool addSwapStones(const QVector<Chess::Move>& stones);
+		void finishSwapOpening(ChessPlayer* black);
 		bool resetBoard();
 		void initializePgn();
 		void addPgnMove(const Chess::Move& move, const QString& comment);
@@ -143,6 +187,11 @@ class LIB_EXPORT ChessGame : public QObject
 		QSemaphore m_pauseSem;
 		QSemaphore m_resumeSem;
 		GameAdjudicator m_adjudicator;
+		SwapOpening m_swapOpening;
+		SwapStage m_swapStage;
+		ChessPlayer* m_swapPlayer;
+		bool m_playersSwapped;
+		int m_overtimeMoveCount;
 };
 
 #endif // CHESSGAME_H
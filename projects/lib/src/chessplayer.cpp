@@ -104,6 +104,24 @@ void ChessPlayer::go()
 	startThinking();
 }
 
+void ChessPlayer::goSwap()
+{
+	if (m_state == Disconnected)
+		return;
+	setState(Thinking);
+
+	disconnect(this, SIGNAL(ready()), this, SLOT(goSwap()));
+	if (!isReady())
+	{
+		connect(this, SIGNAL(ready()), this, SLOT(goSwap()));
+		return;
+	}
+
+	Q_ASSERT(m_board != nullptr);
+	startClock();
+	startSwapThinking();
+}
+
 void ChessPlayer::quit()
 {
 	setState(Disconnected);
@@ -159,6 +177,11 @@ Chess::Side ChessPlayer::side() const
 	return m_side;
 }
 
+void ChessPlayer::setSide(Chess::Side side)
+{
+	m_side = side;
+}
+
 Chess::Board* ChessPlayer::board()
 {
 	return m_board;
@@ -224,6 +247,15 @@ void ChessPlayer::startPondering()
 {
 }
 
+bool ChessPlayer::supportsSwapOpening() const
+{
+	return false;
+}
+
+void ChessPlayer::startSwapThinking()
+{
+}
+
 void ChessPlayer::clearPonderState()
 {
 }
@@ -282,6 +314,24 @@ void ChessPlayer::emitMove(const Chess::Move& move)
 	emit moveMade(move);
 }
 
+void ChessPlayer::emitSwapDecision(const QVector<Chess::Move>& stones)
+{
+	if (m_state == Thinking)
+		setState(Observing);
+
+	m_timeControl.update();
+	m_eval.setTime(m_timeControl.lastMoveTime());
+
+	m_timer->stop();
+	if (m_timeControl.expired() && !canPlayAfterTimeout())
+	{
+		forfeit(Chess::Result::Timeout);
+		return;
+	}
+
+	emit swapDecisionMade(stones);
+}
+
 void ChessPlayer::kill()
 {
 	setState(Disconnected);
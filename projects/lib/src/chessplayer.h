@@ -107,6 +107,13 @@ class LIB_EXPORT ChessPlayer : public QObject
 
 		/*! Returns the side of the player. */
 		Chess::Side side() const;
+		/*!
+		 * Sets the side of the player to \a side.
+		 *
+		 * This is only needed when the players exchange sides
+		 * during a game, eg. in a swap opening.
+		 */
+		void setSide(Chess::Side side);
 
 		/*!
 		 * Sends the next move of an ongoing game to the player.
@@ -139,6 +146,14 @@ class LIB_EXPORT ChessPlayer : public QObject
 		/*! Returns true if the player is human. */
 		virtual bool isHuman() const = 0;
 
+		/*!
+		 * Returns true if the player can make the decisions of a
+		 * swap opening. The default implementation returns false.
+		 *
+		 * \sa goSwap()
+		 */
+		virtual bool supportsSwapOpening() const;
+
 		/*!
 		 * Returns true if result claims from the engine are validated;
 		 * otherwise returns false.
@@ -167,6 +182,13 @@ class LIB_EXPORT ChessPlayer : public QObject
 		 * the base implementation.
 		 */
 		virtual void go();
+		/*!
+		 * Like go(), but tells the player to make a decision of a
+		 * swap opening in the current position instead of a move.
+		 *
+		 * The decision is sent with the swapDecisionMade() signal.
+		 */
+		void goSwap();
 
 		/*! Terminates the player non-violently. */
 		virtual void quit();
@@ -212,6 +234,13 @@ class LIB_EXPORT ChessPlayer : public QObject
 
 		/*! Signals the player's move. */
 		void moveMade(const Chess::Move& move);
+
+		/*!
+		 * Signals the player's decision in a swap opening: the
+		 * stones in \a stones are added to the board, or the
+		 * player takes the black stones if \a stones is empty.
+		 */
+		void swapDecisionMade(const QVector<Chess::Move>& stones);
 		
 		/*!
 		 * Emitted when the player claims the game to end
@@ -255,6 +284,14 @@ class LIB_EXPORT ChessPlayer : public QObject
 		 */
 		virtual void startThinking() = 0;
 
+		/*!
+		 * Tells the player to start thinking of a swap opening
+		 * decision. Called by goSwap() when the player is ready.
+		 *
+		 * The default implementation does nothing.
+		 */
+		virtual void startSwapThinking();
+
 		/*!
 		 * Returns true if this player can keep playing after running
 		 * out of time; otherwise returns false.
@@ -276,6 +313,11 @@ class LIB_EXPORT ChessPlayer : public QObject
 		 * move came too late.
 		 */
 		void emitMove(const Chess::Move& move);
+		/*!
+		 * Emits the player's swap opening decision, and a timeout
+		 * signal if the decision came too late.
+		 */
+		void emitSwapDecision(const QVector<Chess::Move>& stones);
 		
 		/*! Returns the opposing player. */
 		const ChessPlayer* opponent() const;
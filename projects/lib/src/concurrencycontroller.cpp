@@ -0,0 +1,173 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "concurrencycontroller.h"
+#include <QThread>
+#include "gamemanager.h"
+#include "chessgame.h"
+
+#ifdef Q_OS_UNIX
+  #include <stdlib.h>
+#endif
+
+namespace {
+
+// Highest tolerated share of moves over their time budget. Engines
+// often spend more than the average allotment on difficult moves.
+const double MaxOvertimeRate = 0.1;
+// Load per CPU above which games are taken away
+const double HighLoad = 1.0;
+// Load per CPU below which games are added
+const double LowLoad = 0.8;
+
+} // anonymous namespace
+
+ConcurrencyController::ConcurrencyController(GameManager* manager,
+					     QObject* parent)
+	: QObject(parent),
+	  m_manager(manager),
+	  m_minimum(1),
+	  m_maximum(1),
+	  m_interval(0),
+	  m_gameCount(0),
+	  m_timeLosses(0),
+	  m_moveCount(0),
+	  m_overtimeMoveCount(0)
+{
+	Q_ASSERT(manager != nullptr);
+}
+
+int ConcurrencyController::minimum() const
+{
+	return m_minimum;
+}
+
+int ConcurrencyController::maximum() const
+{
+	return m_maximum;
+}
+
+void ConcurrencyController::setRange(int minimum, int maximum)
+{
+	Q_ASSERT(minimum > 0);
+	Q_ASSERT(maximum >= minimum);
+
+	m_minimum = minimum;
+	m_maximum = maximum;
+	m_manager->setConcurrency(qBound(minimum,
+					 m_manager->concurrency(),
+					 maximum));
+}
+
+int ConcurrencyController::interval() const
+{
+	return m_interval;
+}
+
+void ConcurrencyController::setInterval(int games)
+{
+	Q_ASSERT(games >= 0);
+	m_interval = games;
+}
+
+double ConcurrencyController::systemLoad()
+{
+#ifdef Q_OS_UNIX
+	double loadAvg = 0.0;
+	if (getloadavg(&loadAvg, 1) == 1)
+		return loadAvg / qMax(QThread::idealThreadCount(), 1);
+#endif
+	return -1.0;
+}
+
+double ConcurrencyController::load() const
+{
+	return systemLoad();
+}
+
+void ConcurrencyController::addGame(ChessGame* game)
+{
+	Q_ASSERT(game != nullptr);
+
+	addGame(game->result().type() == Chess::Result::Timeout,
+		game->moves().size(),
+		game->overtimeMoveCount());
+}
+
+void ConcurrencyController::addGame(bool timeLoss,
+				    int moveCount,
+				    int overtimeMoveCount)
+{
+	m_gameCount++;
+	if (timeLoss)
+		m_timeLosses++;
+	m_moveCount += moveCount;
+	m_overtimeMoveCount += overtimeMoveCount;
+
+	const int window = m_interval > 0 ? m_interval
+					  : qMax(m_manager->concurrency(), 2);
+	if (m_gameCount >= window)
+		decide();
+}
+
+void ConcurrencyController::decide()
+{
+	const int oldValue = m_manager->concurrency();
+	const double overtimeRate = m_moveCount > 0
+		? double(m_overtimeMoveCount) / m_moveCount : 0.0;
+	const double currentLoad = load();
+	const QString loadStr = currentLoad < 0.0
+		? QString("unknown")
+		: QString::number(currentLoad, 'f', 2);
+
+	int newValue = oldValue;
+	QString reason;
+	if (m_timeLosses > 0 || overtimeRate > MaxOvertimeRate)
+	{
+		newValue = oldValue - qMax(oldValue / 4, 1);
+		reason = QString("%1 of %2 games lost on time, "
+				 "%3 of %4 moves over budget")
+			 .arg(m_timeLosses).arg(m_gameCount)
+			 .arg(m_overtimeMoveCount).arg(m_moveCount);
+	}
+	else if (currentLoad > HighLoad)
+	{
+		newValue = oldValue - 1;
+		reason = QString("load per CPU %1").arg(loadStr);
+	}
+	else if (currentLoad < 0.0)
+		reason = "load unknown";
+	else if (currentLoad <= LowLoad)
+	{
+		newValue = oldValue + 1;
+		reason = QString("no time losses in %1 games, load per CPU %2")
+			 .arg(m_gameCount).arg(loadStr);
+	}
+	else
+		reason = QString("load per CPU %1").arg(loadStr);
+
+	newValue = qBound(m_minimum, newValue, m_maximum);
+	m_gameCount = 0;
+	m_timeLosses = 0;
+	m_moveCount = 0;
+	m_overtimeMoveCount = 0;
+
+	if (newValue != oldValue)
+		m_manager->setConcurrency(newValue);
+	emit decisionMade(oldValue, newValue, reason);
+}
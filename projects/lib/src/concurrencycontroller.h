@@ -0,0 +1,129 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CONCURRENCYCONTROLLER_H
+#define CONCURRENCYCONTROLLER_H
+
+#include <QObject>
+class GameManager;
+class ChessGame;
+
+/*!
+ * \brief Adjusts the concurrency of a GameManager during a match
+ *
+ * The controller collects the results of finished games in windows
+ * of interval() games. At the end of each window it looks at the
+ * number of games lost on time, the share of moves that took longer
+ * than their time budget, and the system load average, and then
+ * decides the new concurrency limit:
+ * - after a time loss or too many overtime moves the limit is cut
+ *   by a quarter
+ * - if the system is overloaded the limit is lowered by one
+ * - if the system has idle CPUs the limit is raised by one
+ *
+ * Without a load average (eg. on Windows) the limit is never raised,
+ * only lowered after time losses or overtime moves.
+ *
+ * The limit always stays between minimum() and maximum(). Every
+ * decision, including keeping the old limit, is reported with the
+ * decisionMade() signal.
+ *
+ * \sa GameManager::setConcurrency(), ChessGame::overtimeMoveCount()
+ */
+class LIB_EXPORT ConcurrencyController : public QObject
+{
+	Q_OBJECT
+
+	public:
+		/*! Creates a new controller for \a manager. */
+		ConcurrencyController(GameManager* manager,
+				      QObject* parent = nullptr);
+
+		/*! Returns the lowest allowed concurrency. */
+		int minimum() const;
+		/*! Returns the highest allowed concurrency. */
+		int maximum() const;
+		/*!
+		 * Sets the allowed concurrency range to [\a minimum, \a maximum]
+		 * and moves the game manager's concurrency into it.
+		 */
+		void setRange(int minimum, int maximum);
+
+		/*!
+		 * Returns the number of games between decisions, or 0 if
+		 * a decision is made after every "generation" of games,
+		 * ie. as many games as the current concurrency (the default).
+		 */
+		int interval() const;
+		/*! Sets the number of games between decisions to \a games. */
+		void setInterval(int games);
+
+		/*!
+		 * Returns the load average of the last minute divided by
+		 * the number of CPUs, or a negative value if the load
+		 * average isn't available on this platform.
+		 */
+		static double systemLoad();
+
+	public slots:
+		/*!
+		 * Adds the finished game \a game to the statistics.
+		 *
+		 * \note \a game must not be running.
+		 */
+		void addGame(ChessGame* game);
+		/*!
+		 * Adds a finished game of \a moveCount moves to the
+		 * statistics. \a timeLoss is true if the game was lost on
+		 * time, and \a overtimeMoveCount is the number of moves
+		 * that took longer than their time budget.
+		 */
+		void addGame(bool timeLoss, int moveCount, int overtimeMoveCount);
+
+	signals:
+		/*!
+		 * This signal is emitted when the controller has decided
+		 * to change the concurrency from \a oldConcurrency to
+		 * \a newConcurrency (which can be the same) because of
+		 * \a reason.
+		 */
+		void decisionMade(int oldConcurrency,
+				  int newConcurrency,
+				  const QString& reason);
+
+	protected:
+		/*!
+		 * Returns the current system load per CPU.
+		 * The default implementation returns systemLoad().
+		 */
+		virtual double load() const;
+
+	private:
+		void decide();
+
+		GameManager* m_manager;
+		int m_minimum;
+		int m_maximum;
+		int m_interval;
+		int m_gameCount;
+		int m_timeLosses;
+		int m_moveCount;
+		int m_overtimeMoveCount;
+};
+
+#endif // CONCURRENCYCONTROLLER_H
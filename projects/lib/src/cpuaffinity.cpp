@@ -0,0 +1,232 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cpuaffinity.h"
+#include <QThread>
+#include <QStringList>
+
+#ifdef Q_OS_LINUX
+  #include <QDir>
+  #include <sched.h>
+#endif
+
+namespace {
+
+// Parses a list like "0-3,8,10-11" of CPUs in \a available
+bool parseCpuList(const QString& str,
+		  const QList<int>& available,
+		  QList<int>* cpus)
+{
+	const QStringList ranges = str.split(',');
+	for (const QString& range : ranges)
+	{
+		const int sep = range.indexOf('-');
+		bool ok1 = false;
+		bool ok2 = false;
+		int first = range.left(sep == -1 ? range.size() : sep).toInt(&ok1);
+		int last = (sep == -1) ? first : range.mid(sep + 1).toInt(&ok2);
+		if (!ok1 || (sep != -1 && !ok2) || first < 0 || last < first)
+			return false;
+
+		for (int cpu = first; cpu <= last; cpu++)
+		{
+			if (!available.contains(cpu))
+				return false;
+			cpus->append(cpu);
+		}
+	}
+
+	return !cpus->isEmpty();
+}
+
+} // anonymous namespace
+
+CpuAffinity::CpuAffinity()
+	: m_policy(NoAffinity)
+{
+}
+
+bool CpuAffinity::parse(const QString& str, const QList<int>& available)
+{
+	Policy policy;
+	QList<int> cpus;
+
+	if (str == "compact" || str == "spread")
+	{
+		policy = (str == "compact") ? Compact : Spread;
+		cpus = available;
+	}
+	else if (str.startsWith("list:"))
+	{
+		policy = List;
+		if (!parseCpuList(str.mid(5), available, &cpus))
+			return false;
+	}
+	else
+		return false;
+
+	if (cpus.isEmpty())
+		return false;
+
+	// Two CPUs per game. An odd CPU gets a slot of its own.
+	QList< QList<int> > pairs;
+	for (int i = 0; i < cpus.size(); i += 2)
+		pairs << cpus.mid(i, 2);
+
+	m_slots.clear();
+	if (policy == Spread)
+	{
+		// Alternate between the two halves
+		const int half = (pairs.size() + 1) / 2;
+		for (int i = 0; i < half; i++)
+		{
+			m_slots << pairs.at(i);
+			if (half + i < pairs.size())
+				m_slots << pairs.at(half + i);
+		}
+	}
+	else
+		m_slots = pairs;
+
+	m_policy = policy;
+	m_cpuList = (policy == List) ? str.mid(5) : QString();
+	return true;
+}
+
+CpuAffinity::Policy CpuAffinity::policy() const
+{
+	return m_policy;
+}
+
+bool CpuAffinity::isEnabled() const
+{
+	return m_policy != NoAffinity;
+}
+
+QString CpuAffinity::toString() const
+{
+	switch (m_policy)
+	{
+	case Compact:
+		return "compact";
+	case Spread:
+		return "spread";
+	case List:
+		return "list:" + m_cpuList;
+	default:
+		return QString();
+	}
+}
+
+int CpuAffinity::slotCount() const
+{
+	return m_slots.size();
+}
+
+QList<int> CpuAffinity::cpus(int slot) const
+{
+	if (m_slots.isEmpty() || slot < 0)
+		return QList<int>();
+	return m_slots.at(slot % m_slots.size());
+}
+
+bool CpuAffinity::isSupported()
+{
+#ifdef Q_OS_LINUX
+	return true;
+#else
+	return false;
+#endif
+}
+
+QList<int> CpuAffinity::availableCpus()
+{
+	QList<int> cpus;
+
+#ifdef Q_OS_LINUX
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(set), &set) == 0)
+	{
+		for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+		{
+			if (CPU_ISSET(cpu, &set))
+				cpus << cpu;
+		}
+		if (!cpus.isEmpty())
+			return cpus;
+	}
+#endif
+
+	const int count = qMax(QThread::idealThreadCount(), 1);
+	for (int i = 0; i < count; i++)
+		cpus << i;
+	return cpus;
+}
+
+QString CpuAffinity::cpuListString(const QList<int>& cpus)
+{
+	QStringList ranges;
+	int i = 0;
+	while (i < cpus.size())
+	{
+		int j = i;
+		while (j + 1 < cpus.size() && cpus.at(j + 1) == cpus.at(j) + 1)
+			j++;
+
+		if (j == i)
+			ranges << QString::number(cpus.at(i));
+		else
+			ranges << QString("%1-%2").arg(cpus.at(i)).arg(cpus.at(j));
+		i = j + 1;
+	}
+
+	return ranges.join(',');
+}
+
+bool CpuAffinity::setProcessAffinity(qint64 pid, const QList<int>& cpus)
+{
+#ifdef Q_OS_LINUX
+	if (pid <= 0 || cpus.isEmpty())
+		return false;
+
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (int cpu : cpus)
+		CPU_SET(cpu, &set);
+
+	// A thread created before this call keeps its old affinity,
+	// so every thread of the process is pinned
+	const QStringList tasks = QDir(QString("/proc/%1/task").arg(pid))
+		.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+	if (tasks.isEmpty())
+		return sched_setaffinity(pid_t(pid), sizeof(set), &set) == 0;
+
+	bool ok = true;
+	for (const QString& task : tasks)
+	{
+		if (sched_setaffinity(pid_t(task.toLongLong()), sizeof(set), &set) != 0)
+			ok = false;
+	}
+	return ok;
+#else
+	Q_UNUSED(pid);
+	Q_UNUSED(cpus);
+	return false;
+#endif
+}
@@ -0,0 +1,108 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CPUAFFINITY_H
+#define CPUAFFINITY_H
+
+#include <QList>
+#include <QString>
+
+/*!
+ * \brief A policy for pinning engine processes to CPUs
+ *
+ * The CPUs that the process may run on (see availableCpus()) are
+ * divided into game slots of two CPUs each, one for each engine of
+ * a game. The policy decides which CPUs are used and in what order
+ * the game slots are handed out:
+ * - "compact" uses all available CPUs, and neighbouring games get
+ *   neighbouring CPUs
+ * - "spread" uses all available CPUs, and consecutive games
+ *   alternate between the lower and upper half of the CPUs, which
+ *   usually are different sockets or NUMA nodes
+ * - "list:CPUS" uses only the CPUs in CPUS (eg. "list:0-15,32-47")
+ *   in the given order
+ *
+ * If there are more games than slots, the slots are shared.
+ *
+ * \note Pinning is only supported on Linux; see isSupported().
+ */
+class LIB_EXPORT CpuAffinity
+{
+	public:
+		/*! The placement policy. */
+		enum Policy
+		{
+			NoAffinity,	//!< Processes are not pinned
+			Compact,	//!< Neighbouring games on neighbouring CPUs
+			Spread,		//!< Consecutive games far apart
+			List		//!< Like Compact with a list of CPUs
+		};
+
+		/*! Creates a policy that doesn't pin any processes. */
+		CpuAffinity();
+
+		/*!
+		 * Parses the policy from \a str for a process that may
+		 * run on the CPUs in \a cpus. Returns false if \a str isn't
+		 * valid or uses other CPUs, in which case the policy
+		 * doesn't change.
+		 */
+		bool parse(const QString& str,
+			   const QList<int>& cpus = CpuAffinity::availableCpus());
+
+		/*! Returns the policy. */
+		Policy policy() const;
+		/*! Returns true if processes are pinned. */
+		bool isEnabled() const;
+		/*! Returns the policy as a string accepted by parse(). */
+		QString toString() const;
+
+		/*! Returns the number of game slots. */
+		int slotCount() const;
+		/*!
+		 * Returns the CPUs of game slot \a slot. Slots past
+		 * slotCount() wrap around.
+		 */
+		QList<int> cpus(int slot) const;
+
+		/*! Returns true if processes can be pinned on this platform. */
+		static bool isSupported();
+		/*!
+		 * Returns the CPUs that this process may run on, in
+		 * ascending order. Only these CPUs can be given to the
+		 * engine processes, eg. under taskset or a cgroup cpuset.
+		 */
+		static QList<int> availableCpus();
+		/*! Returns \a cpus in the "0-3,8" format. */
+		static QString cpuListString(const QList<int>& cpus);
+		/*!
+		 * Pins every thread of process \a pid to \a cpus.
+		 * Returns true if successful.
+		 *
+		 * \note Only Linux is supported; on other platforms
+		 * this function returns false.
+		 */
+		static bool setProcessAffinity(qint64 pid, const QList<int>& cpus);
+
+	private:
+		Policy m_policy;
+		QString m_cpuList;
+		QList< QList<int> > m_slots;
+};
+
+#endif // CPUAFFINITY_H
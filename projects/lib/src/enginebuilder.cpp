@@ -76,7 +76,13 @@ ChessPlayer* EngineBuilder::create(QObject* receiver,
 	else
 		process->start(cmd);
 
+#ifdef Q_OS_WIN32
 	bool ok = process->waitForStarted();
+#else
+	// Don't wait for the process to start; ChessEngine::start()
+	// will do that without blocking
+	bool ok = process->state() != QProcess::NotRunning;
+#endif
 	if (!ok)
 	{
 		setError(error, tr("Cannot execute command: %1")
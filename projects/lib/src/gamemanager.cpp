@@ -18,10 +18,14 @@
 
 #include "gamemanager.h"
 #include <QThread>
+#include <QMetaMethod>
+#include <QStringList>
 #include <algorithm>
 #include "playerbuilder.h"
+#include "playerpool.h"
 #include "chessgame.h"
 #include "chessplayer.h"
+#include "chessengine.h"
 
 class GameInitializer : public QObject
 {
@@ -29,16 +33,22 @@ class GameInitializer : public QObject
 
 	public:
 		GameInitializer(const PlayerBuilder* white,
-				const PlayerBuilder* black);
+				const PlayerBuilder* black,
+				QObject* debugReceiver);
 		virtual ~GameInitializer();
 
 		const PlayerBuilder* whiteBuilder() const;
 		const PlayerBuilder* blackBuilder() const;
+		ChessPlayer* player(int index) const;
+		void setPlayer(int index, ChessPlayer* player);
 		void swapPlayers();
 		void setGame(ChessGame* game);
+		void setPlayerPool(PlayerPool* pool);
+		void setCpus(const QList<int>& cpus);
 
 	public slots:
 		void initializeGame();
+		void releasePlayers();
 		void finish();
 
 	signals:
@@ -46,23 +56,31 @@ class GameInitializer : public QObject
 		void finished();
 
 	private slots:
+		void onPlayerReady();
 		void onPlayerQuit();
 
 	private:
 		void deletePlayer(int index);
+		void finishInitialization();
 
 		int m_playerCount;
 		bool m_finishing;
 		const PlayerBuilder* m_builder[2];
 		ChessPlayer* m_player[2];
 		ChessGame* m_game;
+		PlayerPool* m_playerPool;
+		QObject* m_debugReceiver;
+		QList<int> m_cpus;
 };
 
 GameInitializer::GameInitializer(const PlayerBuilder* white,
-				 const PlayerBuilder* black)
+				 const PlayerBuilder* black,
+				 QObject* debugReceiver)
 	: m_playerCount(0),
 	  m_finishing(false),
-	  m_game(nullptr)
+	  m_game(nullptr),
+	  m_playerPool(nullptr),
+	  m_debugReceiver(debugReceiver)
 {
 	Q_ASSERT(white != nullptr);
 	Q_ASSERT(black != nullptr);
@@ -95,6 +113,17 @@ const PlayerBuilder* GameInitializer::blackBuilder() const
 	return m_builder[Chess::Side::Black];
 }
 
+ChessPlayer* GameInitializer::player(int index) const
+{
+	return m_player[index];
+}
+
+void GameInitializer::setPlayer(int index, ChessPlayer* player)
+{
+	Q_ASSERT(m_player[index] == nullptr);
+	m_player[index] = player;
+}
+
 void GameInitializer::swapPlayers()
 {
 	std::swap(m_builder[0], m_builder[1]);
@@ -106,6 +135,16 @@ void GameInitializer::setGame(ChessGame* game)
 	m_game = game;
 }
 
+void GameInitializer::setPlayerPool(PlayerPool* pool)
+{
+	m_playerPool = pool;
+}
+
+void GameInitializer::setCpus(const QList<int>& cpus)
+{
+	m_cpus = cpus;
+}
+
 void GameInitializer::deletePlayer(int index)
 {
 	ChessPlayer* player = m_player[index];
@@ -138,7 +177,7 @@ void GameInitializer::initializeGame()
 		if (m_player[i] == nullptr)
 		{
 			QString error;
-			m_player[i] = m_builder[i]->create(thread()->parent(),
+			m_player[i] = m_builder[i]->create(m_debugReceiver,
 							   SIGNAL(debugMessage(QString)),
 							   this, &error);
 			m_game->setError(error);
@@ -152,13 +191,122 @@ void GameInitializer::initializeGame()
 				return;
 			}
 		}
+		// A player from the pool has no parent yet
+		else if (m_player[i]->parent() == nullptr)
+			m_player[i]->setParent(this);
 		m_game->setPlayer(Chess::Side::Type(i), m_player[i]);
 	}
 	m_playerCount = 2;
 
+	// New engines start in parallel. Wait until both have
+	// finished their handshake.
+	bool ready = true;
+	for (int i = 0; i < 2; i++)
+	{
+		ChessPlayer* player = m_player[i];
+		if (!player->isReady()
+		&&  player->state() != ChessPlayer::Disconnected)
+		{
+			ready = false;
+			connect(player, SIGNAL(ready()),
+				this, SLOT(onPlayerReady()));
+			connect(player, SIGNAL(disconnected()),
+				this, SLOT(onPlayerReady()));
+		}
+	}
+	if (ready)
+		finishInitialization();
+}
+
+void GameInitializer::onPlayerReady()
+{
+	ChessPlayer* sender = qobject_cast<ChessPlayer*>(QObject::sender());
+	Q_ASSERT(sender != nullptr);
+
+	disconnect(sender, SIGNAL(ready()),
+		   this, SLOT(onPlayerReady()));
+	disconnect(sender, SIGNAL(disconnected()),
+		   this, SLOT(onPlayerReady()));
+
+	for (int i = 0; i < 2; i++)
+	{
+		if (m_player[i] != nullptr
+		&&  !m_player[i]->isReady()
+		&&  m_player[i]->state() != ChessPlayer::Disconnected)
+			return;
+	}
+
+	finishInitialization();
+}
+
+void GameInitializer::finishInitialization()
+{
+	QStringList pinnedCpus;
+	bool pinned = !m_cpus.isEmpty();
+
+	for (int i = 0; i < 2; i++)
+	{
+		auto engine = qobject_cast<ChessEngine*>(m_player[i]);
+		if (engine == nullptr)
+			continue;
+
+		// An engine that crashes during the handshake loses the
+		// game, but a command that can't be executed is an error
+		if (engine->failedToStart())
+		{
+			m_game->setError(engine->errorString());
+			m_playerCount = 0;
+			deletePlayer(0);
+			deletePlayer(1);
+
+			emit gameInitialized(false);
+			return;
+		}
+
+		// Pin the engine again for every game: it may have been
+		// restarted or taken from the pool
+		if (m_cpus.isEmpty())
+			continue;
+		const int cpu = m_cpus.at(i % m_cpus.size());
+		if (engine->state() != ChessPlayer::Disconnected
+		&&  engine->setCpuAffinity(QList<int>() << cpu))
+			pinnedCpus << QString::number(cpu);
+		else
+		{
+			qWarning("Could not set the CPU affinity of %s",
+				 qUtf8Printable(engine->name()));
+			pinned = false;
+		}
+	}
+
+	// Only record the CPUs if the engines really run on them
+	if (pinned && !pinnedCpus.isEmpty())
+		m_game->pgn()->setTag("CpuAffinity", pinnedCpus.join(','));
+
 	emit gameInitialized(true);
 }
 
+void GameInitializer::releasePlayers()
+{
+	Q_ASSERT(m_playerPool != nullptr);
+
+	for (int i = 0; i < 2; i++)
+	{
+		ChessPlayer* player = m_player[i];
+		if (player == nullptr
+		||  player->state() == ChessPlayer::Disconnected)
+			continue;
+
+		m_player[i] = nullptr;
+		m_playerCount--;
+
+		player->setParent(nullptr);
+		player->moveToThread(m_playerPool->thread());
+		// The pool's thread is blocked until this function returns
+		m_playerPool->add(m_builder[i], player);
+	}
+}
+
 void GameInitializer::finish()
 {
 	if (m_finishing)
@@ -190,21 +338,32 @@ void GameInitializer::onPlayerQuit()
 }
 
 
-class GameThread : public QThread
+/*!
+ * A slot for games between the players of two builders.
+ *
+ * The slot lives in the manager's thread. Its initializer, players
+ * and game live in a worker thread that can be shared with other
+ * slots.
+ */
+class GameSlot : public QObject
 {
 	Q_OBJECT
 
 	public:
-		GameThread(const PlayerBuilder* white,
-			   const PlayerBuilder* black,
-			   QObject* parent);
-		virtual ~GameThread();
+		GameSlot(const PlayerBuilder* white,
+			 const PlayerBuilder* black,
+			 QThread* worker,
+			 QObject* debugReceiver,
+			 QObject* parent);
 
 		bool isReady() const;
 		void newGame(ChessGame* game);
 		void finish();
-		void finishAndDelete();
 
+		QThread* worker() const;
+		int affinitySlot() const;
+		void setAffinitySlot(int slot, const QList<int>& cpus);
+		QList<int> cpus() const;
 		GameInitializer* initializer() const;
 		ChessGame* game() const;
 		GameManager::StartMode startMode() const;
@@ -216,6 +375,8 @@ class GameThread : public QThread
 	signals:
 		void gameInitialized(bool success);
 		void ready();
+		/*! Emitted when the slot's players are gone. */
+		void finished();
 
 	private slots:
 		void onGameDestroyed();
@@ -225,40 +386,45 @@ class GameThread : public QThread
 		GameManager::StartMode m_startMode;
 		GameManager::CleanupMode m_cleanupMode;
 		ChessGame* m_game;
+		QThread* m_worker;
+		int m_affinitySlot;
+		QList<int> m_cpus;
 		GameInitializer* m_initializer;
 };
 
-GameThread::GameThread(const PlayerBuilder* white,
-		       const PlayerBuilder* black,
-		       QObject* parent)
-	: QThread(parent),
+GameSlot::GameSlot(const PlayerBuilder* white,
+		   const PlayerBuilder* black,
+		   QThread* worker,
+		   QObject* debugReceiver,
+		   QObject* parent)
+	: QObject(parent),
 	  m_ready(true),
 	  m_startMode(GameManager::StartImmediately),
 	  m_cleanupMode(GameManager::DeletePlayers),
 	  m_game(nullptr),
-	  m_initializer(new GameInitializer(white, black))
+	  m_worker(worker),
+	  m_affinitySlot(-1),
+	  m_initializer(new GameInitializer(white, black, debugReceiver))
 {
+	Q_ASSERT(worker != nullptr);
+
 	connect(m_initializer, SIGNAL(gameInitialized(bool)),
 		this, SIGNAL(gameInitialized(bool)));
 	connect(m_initializer, SIGNAL(finished()),
 		m_initializer, SLOT(deleteLater()),
 		Qt::QueuedConnection);
 	connect(m_initializer, SIGNAL(destroyed()),
-		this, SLOT(quit()),
+		this, SIGNAL(finished()),
 		Qt::QueuedConnection);
-	m_initializer->moveToThread(this);
+	m_initializer->moveToThread(worker);
 }
 
-GameThread::~GameThread()
-{
-}
-
-bool GameThread::isReady() const
+bool GameSlot::isReady() const
 {
 	return m_ready;
 }
 
-void GameThread::newGame(ChessGame* game)
+void GameSlot::newGame(ChessGame* game)
 {
 	m_ready = false;
 	m_game = game;
@@ -271,7 +437,7 @@ void GameThread::newGame(ChessGame* game)
 				  Qt::QueuedConnection);
 }
 
-void GameThread::finish()
+void GameSlot::finish()
 {
 	if (m_initializer == nullptr)
 		return;
@@ -287,43 +453,59 @@ void GameThread::finish()
 	m_initializer = nullptr;
 }
 
-void GameThread::finishAndDelete()
+QThread* GameSlot::worker() const
+{
+	return m_worker;
+}
+
+int GameSlot::affinitySlot() const
+{
+	return m_affinitySlot;
+}
+
+void GameSlot::setAffinitySlot(int slot, const QList<int>& cpus)
+{
+	m_affinitySlot = slot;
+	m_cpus = cpus;
+	m_initializer->setCpus(cpus);
+}
+
+QList<int> GameSlot::cpus() const
 {
-	connect(this, SIGNAL(finished()), this, SLOT(deleteLater()));
-	finish();
+	return m_cpus;
 }
 
-GameInitializer* GameThread::initializer() const
+GameInitializer* GameSlot::initializer() const
 {
 	return m_initializer;
 }
 
-ChessGame* GameThread::game() const
+ChessGame* GameSlot::game() const
 {
 	return m_game;
 }
 
-GameManager::StartMode GameThread::startMode() const
+GameManager::StartMode GameSlot::startMode() const
 {
 	return m_startMode;
 }
 
-GameManager::CleanupMode GameThread::cleanupMode() const
+GameManager::CleanupMode GameSlot::cleanupMode() const
 {
 	return m_cleanupMode;
 }
 
-void GameThread::setStartMode(GameManager::StartMode mode)
+void GameSlot::setStartMode(GameManager::StartMode mode)
 {
 	m_startMode = mode;
 }
 
-void GameThread::setCleanupMode(GameManager::CleanupMode mode)
+void GameSlot::setCleanupMode(GameManager::CleanupMode mode)
 {
 	m_cleanupMode = mode;
 }
 
-void GameThread::onGameDestroyed()
+void GameSlot::onGameDestroyed()
 {
 	m_ready = true;
 	emit ready();
@@ -333,9 +515,13 @@ void GameThread::onGameDestroyed()
 GameManager::GameManager(QObject* parent)
 	: QObject(parent),
 	  m_finishing(false),
+	  m_cleaningUp(false),
 	  m_concurrency(1),
-	  m_activeQueuedGameCount(0)
+	  m_workerCount(0),
+	  m_activeQueuedGameCount(0),
+	  m_playerPool(new PlayerPool(this))
 {
+	m_playerPool->setCapacity(2 * m_concurrency);
 }
 
 QList<ChessGame*> GameManager::activeGames() const
@@ -350,54 +536,230 @@ int GameManager::concurrency() const
 
 void GameManager::setConcurrency(int concurrency)
 {
+	const bool grows = concurrency > m_concurrency;
 	m_concurrency = concurrency;
+
+	// Keep enough idle players for the next pairing of every game
+	m_playerPool->setCapacity(2 * qMax(concurrency, 1));
+
+	// Fill the new game slots of a running match. The queue is
+	// serviced later because this could be called from a slot
+	// that is handling a finished game.
+	if (grows && m_activeQueuedGameCount > 0 && !m_finishing)
+		QMetaObject::invokeMethod(this, "startQueuedGame",
+					  Qt::QueuedConnection);
+}
+
+int GameManager::workerCount() const
+{
+	return m_workerCount;
+}
+
+void GameManager::setWorkerCount(int count)
+{
+	Q_ASSERT(count >= 0);
+	m_workerCount = count;
+}
+
+CpuAffinity GameManager::cpuAffinity() const
+{
+	return m_cpuAffinity;
+}
+
+void GameManager::setCpuAffinity(const CpuAffinity& affinity)
+{
+	m_cpuAffinity = affinity;
+}
+
+QList<int> GameManager::gameCpus(const ChessGame* game) const
+{
+	for (GameSlot* slot : m_activeSlots)
+	{
+		if (!slot->isReady() && slot->game() == game)
+			return slot->cpus();
+	}
+	return QList<int>();
 }
 
 void GameManager::cleanupIdleThreads()
 {
-	QList<GameThread*>::iterator it = m_activeThreads.begin();
-	while (it != m_activeThreads.end())
+	QList<GameSlot*>::iterator it = m_activeSlots.begin();
+	while (it != m_activeSlots.end())
 	{
-		GameThread* thread = *it;
-		Q_ASSERT(thread != nullptr);
+		GameSlot* slot = *it;
+		Q_ASSERT(slot != nullptr);
 
-		if (thread->isReady())
+		if (slot->isReady())
 		{
-			it = m_activeThreads.erase(it);
-			thread->finishAndDelete();
+			it = m_activeSlots.erase(it);
+			slot->finish();
 		}
 		else
 			++it;
 	}
+
+	m_playerPool->clear();
+}
+
+void GameManager::releaseIdleSlots()
+{
+	QList<GameSlot*>::iterator it = m_activeSlots.begin();
+	while (it != m_activeSlots.end())
+	{
+		GameSlot* slot = *it;
+		Q_ASSERT(slot != nullptr);
+
+		if (!slot->isReady())
+		{
+			++it;
+			continue;
+		}
+
+		// The slot's players wait in the pool for another
+		// pairing. The initializer is idle, so this thread can
+		// block until they have been moved over.
+		if (slot->cleanupMode() == ReusePlayers)
+		{
+			slot->initializer()->setPlayerPool(m_playerPool);
+			QMetaObject::invokeMethod(slot->initializer(),
+						  "releasePlayers",
+						  Qt::BlockingQueuedConnection);
+		}
+
+		it = m_activeSlots.erase(it);
+		slot->finish();
+	}
+}
+
+void GameManager::takePooledPlayers(GameSlot* slot)
+{
+	GameInitializer* initializer = slot->initializer();
+	const PlayerBuilder* builders[2] = {
+		initializer->whiteBuilder(),
+		initializer->blackBuilder()
+	};
+
+	for (int i = 0; i < 2; i++)
+	{
+		if (initializer->player(i) != nullptr)
+			continue;
+
+		ChessPlayer* player = m_playerPool->take(builders[i]);
+		if (player == nullptr)
+			continue;
+
+		player->moveToThread(slot->worker());
+		initializer->setPlayer(i, player);
+	}
+}
+
+QThread* GameManager::acquireWorker()
+{
+	// Without a worker pool every slot gets a thread of its own
+	if (m_workerCount <= 0)
+	{
+		QThread* thread = new QThread(this);
+		thread->start();
+		return thread;
+	}
+
+	// Use the least busy worker. A new worker is only started
+	// when every existing worker is busy.
+	int best = -1;
+	for (int i = 0; i < m_workers.size(); i++)
+	{
+		if (best == -1 || m_workerLoads.at(i) < m_workerLoads.at(best))
+			best = i;
+	}
+	if ((best == -1 || m_workerLoads.at(best) > 0)
+	&&  m_workers.size() < m_workerCount)
+	{
+		QThread* worker = new QThread(this);
+		worker->start();
+		m_workers << worker;
+		m_workerLoads << 0;
+		best = m_workers.size() - 1;
+	}
+
+	m_workerLoads[best]++;
+	return m_workers.at(best);
+}
+
+void GameManager::releaseWorker(QThread* worker)
+{
+	const int index = m_workers.indexOf(worker);
+	if (index != -1)
+	{
+		m_workerLoads[index]--;
+		return;
+	}
+
+	// The slot's objects are gone, so the thread is idle
+	worker->quit();
+	worker->wait();
+	delete worker;
+}
+
+bool GameManager::hasDebugReceivers() const
+{
+	static const QMetaMethod signal =
+		QMetaMethod::fromSignal(&GameManager::debugMessage);
+	return isSignalConnected(signal);
+}
+
+int GameManager::freeAffinitySlot() const
+{
+	// Slots that are no longer active are shutting down, and their
+	// CPUs can be given to a new slot
+	QList<int> used;
+	for (GameSlot* slot : m_activeSlots)
+		used << slot->affinitySlot();
+
+	int index = 0;
+	while (used.contains(index))
+		index++;
+	return index;
+}
+
+void GameManager::stopWorkers()
+{
+	for (QThread* worker : qAsConst(m_workers))
+	{
+		worker->quit();
+		worker->wait();
+		delete worker;
+	}
+	m_workers.clear();
+	m_workerLoads.clear();
 }
 
 void GameManager::cleanup()
 {
 	m_finishing = false;
 
-	// Remove terminated threads from the list
-	QList< QPointer<GameThread> >::iterator it = m_threads.begin();
-	while (it != m_threads.end())
+	// Terminate the pooled players first
+	if (!m_playerPool->isEmpty())
 	{
-		if (*it == nullptr || !(*it)->isRunning())
-			it = m_threads.erase(it);
-		else
-			++it;
+		connect(m_playerPool, SIGNAL(cleared()),
+			this, SLOT(onPlayerPoolCleared()));
+		m_playerPool->clear();
+		return;
 	}
 
-	if (m_threads.isEmpty())
+	m_slots.removeAll(nullptr);
+	m_activeSlots.clear();
+	if (m_slots.isEmpty())
 	{
+		stopWorkers();
 		emit finished();
 		return;
 	}
 
-	// Terminate running threads
-	for (GameThread* thread : qAsConst(m_threads))
-	{
-		connect(thread, SIGNAL(finished()), this, SLOT(onThreadQuit()),
-			Qt::QueuedConnection);
-		thread->finish();
-	}
+	// Terminate the players of the remaining slots
+	m_cleaningUp = true;
+	const auto remaining = m_slots;
+	for (GameSlot* slot : remaining)
+		slot->finish();
 }
 
 void GameManager::finish()
@@ -434,37 +796,46 @@ void GameManager::newGame(ChessGame* game,
 	startQueuedGame();
 }
 
-void GameManager::onThreadQuit()
+void GameManager::onSlotFinished()
 {
-	GameThread* thread = qobject_cast<GameThread*>(QObject::sender());
-	m_threads.removeOne(thread);
+	GameSlot* slot = qobject_cast<GameSlot*>(QObject::sender());
+	Q_ASSERT(slot != nullptr);
 
-	if (thread != nullptr)
-		thread->deleteLater();
+	m_slots.removeOne(slot);
+	m_activeSlots.removeOne(slot);
+	releaseWorker(slot->worker());
+	slot->deleteLater();
 
-	if (m_threads.isEmpty())
+	if (m_cleaningUp && m_slots.isEmpty())
 	{
-		m_finishing = false;
+		m_cleaningUp = false;
+		stopWorkers();
 		emit finished();
 	}
 }
 
-void GameManager::onThreadReady()
+void GameManager::onPlayerPoolCleared()
 {
-	GameThread* thread = qobject_cast<GameThread*>(QObject::sender());
-	Q_ASSERT(thread != nullptr);
-	ChessGame* game = thread->game();
+	disconnect(m_playerPool, SIGNAL(cleared()),
+		   this, SLOT(onPlayerPoolCleared()));
+	cleanup();
+}
+
+void GameManager::onSlotReady()
+{
+	GameSlot* slot = qobject_cast<GameSlot*>(QObject::sender());
+	Q_ASSERT(slot != nullptr);
+	ChessGame* game = slot->game();
 
 	m_activeGames.removeOne(game);
-	m_threads.removeAll(nullptr);
 
-	if (thread->cleanupMode() == DeletePlayers)
+	if (slot->cleanupMode() == DeletePlayers)
 	{
-		m_activeThreads.removeOne(thread);
-		thread->finishAndDelete();
+		m_activeSlots.removeOne(slot);
+		slot->finish();
 	}
 
-	if (thread->startMode() == Enqueue)
+	if (slot->startMode() == Enqueue)
 	{
 		m_activeQueuedGameCount--;
 		startQueuedGame();
@@ -477,30 +848,29 @@ void GameManager::onThreadReady()
 
 void GameManager::onGameInitialized(bool success)
 {
-	GameThread* gameThread = qobject_cast<GameThread*>(sender());
-	Q_ASSERT(gameThread != nullptr);
-	ChessGame* game = gameThread->game();
+	GameSlot* slot = qobject_cast<GameSlot*>(sender());
+	Q_ASSERT(slot != nullptr);
+	ChessGame* game = slot->game();
 
 	if (!success)
 	{
-		if (gameThread->startMode() == Enqueue)
+		if (slot->startMode() == Enqueue)
 			m_activeQueuedGameCount--;
 
-		m_threads.removeOne(gameThread);
-		m_activeThreads.removeOne(gameThread);
+		m_activeSlots.removeOne(slot);
 
-		connect(gameThread, SIGNAL(destroyed()),
+		connect(slot, SIGNAL(destroyed()),
 			game, SLOT(emitStartFailed()));
-		gameThread->finishAndDelete();
+		slot->finish();
 
 		return;
 	}
 
 	m_activeGames << game;
-	if (gameThread->startMode() == Enqueue)
-		cleanupIdleThreads();
+	if (slot->startMode() == Enqueue)
+		releaseIdleSlots();
 
-	game->moveToThread(gameThread);
+	game->moveToThread(slot->worker());
 	connect(game, SIGNAL(started(ChessGame*)),
 		this, SIGNAL(gameStarted(ChessGame*)),
 		Qt::QueuedConnection);
@@ -509,46 +879,61 @@ void GameManager::onGameInitialized(bool success)
 	startQueuedGame();
 }
 
-GameThread* GameManager::getThread(const PlayerBuilder* white,
-				   const PlayerBuilder* black)
+GameSlot* GameManager::getSlot(const PlayerBuilder* white,
+			       const PlayerBuilder* black)
 {
 	Q_ASSERT(white != nullptr);
 	Q_ASSERT(black != nullptr);
 
-	for (GameThread* thread : qAsConst(m_activeThreads))
+	for (GameSlot* slot : qAsConst(m_activeSlots))
 	{
-		if (!thread->isReady())
+		if (!slot->isReady())
 			continue;
 
-		GameInitializer* tmp = thread->initializer();
+		GameInitializer* tmp = slot->initializer();
 		if (tmp->whiteBuilder() == black
 		&&  tmp->blackBuilder() == white)
 			tmp->swapPlayers();
 		if (tmp->whiteBuilder() == white && tmp->blackBuilder() == black)
-			return thread;
+			return slot;
 	}
 
-	GameThread* gameThread = new GameThread(white, black, this);
-	m_threads << gameThread;
-	m_activeThreads << gameThread;
-	connect(gameThread, SIGNAL(ready()),
-		this, SLOT(onThreadReady()));
-	connect(gameThread, SIGNAL(gameInitialized(bool)),
+	// Let the new slot use the players of the idle slots
+	releaseIdleSlots();
+
+	// Without a debug log the players aren't connected to the
+	// manager at all, so they can skip formatting the messages
+	QObject* debugReceiver = hasDebugReceivers() ? this : nullptr;
+	GameSlot* slot = new GameSlot(white, black, acquireWorker(),
+				      debugReceiver, this);
+	if (m_cpuAffinity.isEnabled())
+	{
+		const int index = freeAffinitySlot();
+		slot->setAffinitySlot(index, m_cpuAffinity.cpus(index));
+	}
+	m_slots << slot;
+	m_activeSlots << slot;
+	connect(slot, SIGNAL(ready()),
+		this, SLOT(onSlotReady()));
+	connect(slot, SIGNAL(finished()),
+		this, SLOT(onSlotFinished()));
+	connect(slot, SIGNAL(gameInitialized(bool)),
 		this, SLOT(onGameInitialized(bool)),
 		Qt::QueuedConnection);
 
-	gameThread->start();
-	return gameThread;
+	return slot;
 }
 
 void GameManager::startGame(const GameEntry& entry)
 {
-	GameThread* gameThread = getThread(entry.white, entry.black);
-	Q_ASSERT(gameThread != nullptr);
+	GameSlot* slot = getSlot(entry.white, entry.black);
+	Q_ASSERT(slot != nullptr);
 
-	gameThread->setStartMode(entry.startMode);
-	gameThread->setCleanupMode(entry.cleanupMode);
-	gameThread->newGame(entry.game);
+	slot->setStartMode(entry.startMode);
+	slot->setCleanupMode(entry.cleanupMode);
+	if (entry.cleanupMode == ReusePlayers)
+		takePooledPlayers(slot);
+	slot->newGame(entry.game);
 }
 
 void GameManager::startQueuedGame()
@@ -22,10 +22,13 @@
 #include <QObject>
 #include <QList>
 #include <QPointer>
+#include "cpuaffinity.h"
+class QThread;
 class ChessGame;
 class ChessPlayer;
 class PlayerBuilder;
-class GameThread;
+class PlayerPool;
+class GameSlot;
 
 
 /*!
@@ -33,7 +36,12 @@ class GameThread;
  *
  * GameManager can start games in a new thread, run
  * multiple games concurrently, and queue games to be
- * run when a game slot/thread is free.
+ * run when a game slot is free.
+ *
+ * By default every game slot has a thread of its own. With a
+ * worker pool (see setWorkerCount()) the games and their players
+ * are spread over a fixed number of threads instead, which are
+ * kept alive until finish() is called.
  *
  * \sa ChessGame, PlayerBuilder
  */
@@ -65,6 +73,11 @@ class LIB_EXPORT GameManager : public QObject
 			 * The players are left alive after the game is deleted.
 			 * If a new game with the same builder objects is started,
 			 * the players are reused for that game.
+			 *
+			 * Players of idle game threads are kept in a pool, so a
+			 * new pairing of the same builders gets players that
+			 * are already running. The builder objects must stay
+			 * alive until cleanupIdleThreads() or finish() is called.
 			 */
 			ReusePlayers
 		};
@@ -94,17 +107,71 @@ class LIB_EXPORT GameManager : public QObject
 		/*!
 		 * Sets the concurrency limit to \a concurrency.
 		 *
+		 * The limit can be changed while games are running. If it
+		 * is lowered, running games are not stopped but no new
+		 * queued games are started until there is room for them.
+		 *
+		 * At most two idle players per game wait for a new pairing;
+		 * the players that have been idle the longest are terminated.
+		 *
 		 * \sa concurrency()
 		 */
 		void setConcurrency(int concurrency);
 
 		/*!
-		 * Cleans up and deletes all idle game threads
+		 * Returns the size of the worker thread pool, or 0 if
+		 * every game slot has a thread of its own (the default).
+		 *
+		 * \sa setWorkerCount()
+		 */
+		int workerCount() const;
+		/*!
+		 * Sets the size of the worker thread pool to \a count.
+		 *
+		 * A new game slot is given to the worker with the fewest
+		 * slots, so the games are spread evenly over the workers.
+		 * The players and the game of a slot always stay in the
+		 * same worker. If \a count is 0, every game slot gets a
+		 * new thread.
+		 *
+		 * \note The setting only affects new game slots.
+		 */
+		void setWorkerCount(int count);
+
+		/*!
+		 * Returns the CPU affinity policy of the engine processes.
+		 *
+		 * \sa setCpuAffinity()
+		 */
+		CpuAffinity cpuAffinity() const;
+		/*!
+		 * Sets the CPU affinity policy of the engine processes to
+		 * \a affinity.
+		 *
+		 * Every game slot gets the CPUs of the lowest free affinity
+		 * slot, and each engine of its games is pinned to one of
+		 * them when a game starts. If all engines were pinned, their
+		 * CPUs are stored in the "CpuAffinity" tag of the game's PGN.
+		 *
+		 * \note The setting only affects new game slots.
+		 */
+		void setCpuAffinity(const CpuAffinity& affinity);
+		/*!
+		 * Returns the CPUs reserved for the engines of \a game, or
+		 * an empty list if \a game isn't active or CPU affinity is
+		 * disabled.
+		 */
+		QList<int> gameCpus(const ChessGame* game) const;
+
+		/*!
+		 * Cleans up and deletes all idle game slots
 		 *
 		 * This function cleans up and removes all resources used by
-		 * game threads that are waiting for new games. The resources
-		 * include the players and the thread they're living in. The
-		 * PlayerBuilder objects will not be deleted.
+		 * game slots that are waiting for new games. The resources
+		 * include the players and the thread they're living in, unless
+		 * it's a pooled worker thread. The PlayerBuilder objects will
+		 * not be deleted. The idle players waiting in the player pool
+		 * are terminated as well.
 		 *
 		 * Generally this function should be called after a tournament
 		 * has ended.
@@ -180,13 +247,20 @@ class LIB_EXPORT GameManager : public QObject
 		 * safely deleted.
 		 */
 		void finished();
-		/*! This signal redirects the ChessPlayer::debugMessage() signal. */
+		/*!
+		 * This signal redirects the ChessPlayer::debugMessage() signal.
+		 *
+		 * \note Only players of games that are started while this
+		 * signal is connected send their debug messages.
+		 */
 		void debugMessage(const QString& data);
 
 	private slots:
-		void onThreadReady();
-		void onThreadQuit();
+		void onSlotReady();
+		void onSlotFinished();
 		void onGameInitialized(bool success);
+		void onPlayerPoolCleared();
+		void startQueuedGame();
 
 	private:
 		struct GameEntry
@@ -198,19 +272,31 @@ class LIB_EXPORT GameManager : public QObject
 			CleanupMode cleanupMode;
 		};
 
-		GameThread* getThread(const PlayerBuilder* white,
-				      const PlayerBuilder* black);
+		GameSlot* getSlot(const PlayerBuilder* white,
+				  const PlayerBuilder* black);
+		void releaseIdleSlots();
+		void takePooledPlayers(GameSlot* slot);
+		QThread* acquireWorker();
+		void releaseWorker(QThread* worker);
+		bool hasDebugReceivers() const;
+		int freeAffinitySlot() const;
+		void stopWorkers();
 		void startGame(const GameEntry& entry);
-		void startQueuedGame();
 		void cleanup();
 
 		bool m_finishing;
+		bool m_cleaningUp;
 		int m_concurrency;
+		int m_workerCount;
 		int m_activeQueuedGameCount;
-		QList< QPointer<GameThread> > m_threads;
-		QList<GameThread*> m_activeThreads;
+		CpuAffinity m_cpuAffinity;
+		QList< QPointer<GameSlot> > m_slots;
+		QList<GameSlot*> m_activeSlots;
+		QList<QThread*> m_workers;
+		QList<int> m_workerLoads;
 		QList<GameEntry> m_gameEntries;
 		QList<ChessGame*> m_activeGames;
+		PlayerPool* m_playerPool;
 };
 
 #endif // GAMEMANAGER_H
@@ -24,24 +24,33 @@
 #include <QTimer>
 
 #include <climits>
-#include <iostream>
 
 #include "timecontrol.h"
+#include "trace.h"
 //#include "enginebuttonoption.h"
 //#include "enginecheckoption.h"
 //#include "enginecombooption.h"
-//#include "enginespinoption.h"
-//#include "enginetextoption.h"
+#include "enginespinoption.h"
+#include "enginetextoption.h"
 
 namespace {
 
 const int s_infiniteSec = 86400;
 
+// Time limit of a single search in milliseconds
+int turnTimeout(const TimeControl* tc)
+{
+	if (tc->isInfinite())
+		return s_infiniteSec * 1000;
+	if (tc->timePerMove() > 0)
+		return tc->timePerMove();
+	return qMax(tc->timeLeft(), 0);
+}
+
 } // anonymous namespace
 
 GomocupEngine::GomocupEngine(QObject* parent)
 	: ChessEngine(parent),
-	  m_forceMode(false),
 	  m_drawOnNextMove(false),
 	  m_ftName(false),
 	  m_ftPing(false),
@@ -50,22 +59,56 @@ GomocupEngine::GomocupEngine(QObject* parent)
 	  m_ftUsermove(false),
 	  m_ftReuse(true),
 	  m_ftNps(false),
+	  m_ftRestart(true),
 	  m_gotResult(false),
+	  m_boardSynced(false),
+	  m_restarting(false),
+	  m_swapping(false),
+	  m_startWidth(0),
+	  m_startHeight(0),
+	  m_ponderState(NotPondering),
+	  m_ponderTimeout(false),
 	  m_lastPing(0),
 	  m_notation(Chess::Board::LongAlgebraic),
-	  m_initTimer(new QTimer(this))
+	  m_initTimer(new QTimer(this)),
+	  m_startupLatency(-1)
 {
 	m_initTimer->setSingleShot(true);
 	m_initTimer->setInterval(8000);
 	connect(m_initTimer, SIGNAL(timeout()), this, SLOT(initialize()));
 
 	addVariant("gomoku");
+	addVariant("gomoku-standard");
+	addVariant("caro");
+	addVariant("renju");
 	setName("GomocupEngine");
+
+	// Options that are sent as INFO keys. The memory limit is
+	// given in megabytes; 0 means no limit.
+	addOption(new EngineSpinOption("memory", 0, 0, 0, INT_MAX - 1));
+	addOption(new EngineTextOption("folder", QString(), QString(),
+				       QString(), EngineTextOption::FolderDialog));
+
+	// Keys of the search information in MESSAGE lines. This option
+	// isn't sent to the engine.
+	addOption(new EngineTextOption("message keys",
+				       GomocupEvalParser::DefaultKeys,
+				       GomocupEvalParser::DefaultKeys));
+	// Maximum number of MESSAGE and DEBUG lines per second that
+	// are read; 0 means no limit. This option isn't sent either.
+	addOption(new EngineSpinOption("message rate", 0, 0, 0, INT_MAX - 1));
 }
 
 void GomocupEngine::startProtocol()
 {
-	// Tell the engine to turn on xboard mode
+	m_startupTimer.start();
+	m_startupLatency = -1;
+	m_startWidth = 0;
+	m_startHeight = 0;
+
+	// The first answer to ABOUT means that the engine is ready. The
+	// init timer is only a fallback for engines that stay silent.
+	write("ABOUT", Unbuffered);
 	m_initTimer->start();
 }
 
@@ -73,23 +116,51 @@ void GomocupEngine::initialize()
 {
 	if (state() == Starting)
 	{
+		const bool answered = m_initTimer->isActive();
+		m_initTimer->stop();
+		m_startupLatency = int(m_startupTimer.elapsed());
+
+		if (answered)
+			ccTrace(lcGomocup).noquote() << name() << "ready in"
+				<< m_startupLatency << "ms";
+		else
+			qWarning("%s did not answer ABOUT, assuming it is ready after %d ms",
+				 qUtf8Printable(name()), m_startupLatency);
+
 		onProtocolStart();
 		emit ready();
 	}
 }
 
+int GomocupEngine::startupLatency() const
+{
+	return m_startupLatency;
+}
+
 void GomocupEngine::startGame()
 {
 	m_gotResult = false;
-	m_forceMode = false;
 	m_nextMove = Chess::Move();
+	m_boardSynced = false;
+	m_swapping = false;
+	m_ponderState = NotPondering;
+	m_ponderTimeout = false;
+
+	// The same process can play another game on a board of the same
+	// size after RESTART. Otherwise the board is set up with START.
+	if (m_ftRestart
+	&&  board()->width() == m_startWidth
+	&&  board()->height() == m_startHeight)
+	{
+		m_restarting = true;
+		write("RESTART", Unbuffered);
+	}
+	else
+		sendStart();
 
-	board()->reset();
-
-	write(QString("ABOUT"));
-
-	int boardSize = board()->width();
-	write(QString("START %1").arg(boardSize));
+	// Wait for the OK. The INFO keys are sent after it.
+	ping(false);
+	sendGameInfo();
 	/*
 	m_drawOnNextMove = false;
 	m_gotResult = false;
@@ -172,10 +243,23 @@ void GomocupEngine::startGame()
 	}*/
 }
 
+void GomocupEngine::sendStart()
+{
+	m_startWidth = board()->width();
+	m_startHeight = board()->height();
+
+	if (m_startWidth == m_startHeight)
+		write(QString("START %1").arg(m_startWidth), Unbuffered);
+	else
+		write(QString("RECTSTART %1,%2").arg(m_startWidth).arg(m_startHeight),
+		      Unbuffered);
+}
+
 bool GomocupEngine::restartsBetweenGames() const
 {
+	// Without RESTART a new game needs a new process
 	if (restartMode() == EngineConfiguration::RestartAuto)
-		return !m_ftReuse;
+		return !m_ftReuse || !m_ftRestart;
 	return ChessEngine::restartsBetweenGames();
 }
 
@@ -188,6 +272,18 @@ void GomocupEngine::endGame(const Chess::Result& result)
 	if (s != Thinking)
 		m_gotResult = true;
 
+	// A ponder search can still be running if the game ended
+	// outside a move, eg. on the opponent's time forfeit. Its
+	// reply is the engine's last output of the game, so it
+	// stands in for the pong.
+	const bool stoppingPonder = (m_ponderState == Pondering);
+	if (stoppingPonder)
+	{
+		m_ponderState = StoppingPonder;
+		sendStop();
+		ping(false);
+	}
+
 	stopThinking();
 	//setForceMode(true);
 	//write("result " + result.toVerboseString());
@@ -198,7 +294,7 @@ void GomocupEngine::endGame(const Chess::Result& result)
 	// for a move or a result, or an error, or whatever. We
 	// would like to extend our middle fingers to every engine
 	// developer who fails to support the ping command.
-	if (!m_ftPing && m_gotResult)
+	if (!m_ftPing && m_gotResult && !stoppingPonder)
 		finishGame();
 }
 
@@ -213,6 +309,48 @@ void GomocupEngine::finishGame()
 	}
 }
 
+void GomocupEngine::sendGameInfo()
+{
+	const TimeControl* tc = timeControl();
+	beginWriteBatch();
+
+	// A timeout_turn of 0 would tell the engine to play instantly
+	if (tc->isInfinite())
+	{
+		write(QString("INFO timeout_turn %1").arg(s_infiniteSec * 1000));
+		write("INFO timeout_match 0");
+	}
+	else if (tc->timePerMove() > 0)
+	{
+		write(QString("INFO timeout_turn %1").arg(tc->timePerMove()));
+		write("INFO timeout_match 0");
+	}
+	else
+	{
+		write(QString("INFO timeout_turn %1").arg(tc->timePerTc()));
+		write(QString("INFO timeout_match %1").arg(tc->timePerTc()));
+	}
+
+	sendOption("memory", getOption("memory")->value());
+
+	// Game type: 0 = human opponent, 1 = engine opponent
+	write(QString("INFO game_type %1").arg(opponent()->isHuman() ? 0 : 1));
+
+	// Rule bitmask: 1 = exactly five, 4 = renju, 8 = caro
+	const QString variant = board()->variant();
+	int rule = 0;
+	if (variant == "gomoku-standard")
+		rule = 1;
+	else if (variant == "renju")
+		rule = 4;
+	else if (variant == "caro")
+		rule = 8;
+	write(QString("INFO rule %1").arg(rule));
+
+	sendOption("folder", getOption("folder")->value());
+	endWriteBatch();
+}
+
 void GomocupEngine::sendTimeLeft()
 {/*
 	if (!m_ftTime)
@@ -238,37 +376,26 @@ void GomocupEngine::sendTimeLeft()
 		return;
 	}
 
-	int csLeft = timeControl()->timeLeft();
-	int ocsLeft = opponent()->timeControl()->timeLeft();
-
-	if (csLeft < 0)
-		csLeft = 0;
-	if (ocsLeft < 0)
-		ocsLeft = 0;
-
-	write(QString("INFO time_left %1").arg(csLeft));
-}
+	// Fixed and infinite move times were sent by sendGameInfo(),
+	// unless a ponder search changed them
+	const TimeControl* tc = timeControl();
+	if (tc->isInfinite() || tc->timePerMove() > 0)
+	{
+		if (m_ponderTimeout)
+			write(QString("INFO timeout_turn %1").arg(turnTimeout(tc)));
+		m_ponderTimeout = false;
+		return;
+	}
 
-void GomocupEngine::sendTurnInfo() // other infos except time left
-{
+	int msLeft = turnTimeout(tc);
+	m_ponderTimeout = false;
 
+	// The clock is the only limit for a single move
+	write(QString("INFO timeout_turn %1").arg(msLeft));
+	write(QString("INFO time_left %1").arg(msLeft));
 }
 
 
-void GomocupEngine::setForceMode(bool enable)
-{
-	if (enable && !m_forceMode)
-	{
-		m_forceMode = true;
-
-		// If there's a move pending, and we didn't get the
-		// 'go' command, we'll send the move in force mode.
-		if (!m_nextMove.isNull())
-			makeMove(m_nextMove);
-	}
-	m_forceMode = enable;
-}
-
 QString GomocupEngine::moveString(const Chess::Move& move)
 {
 	Q_ASSERT(!move.isNull());
@@ -279,47 +406,105 @@ void GomocupEngine::makeMove(const Chess::Move& move)
 {
 	Q_ASSERT(!move.isNull());
 
-	QString moveString;
-	if (move == m_nextMove)
-		moveString = m_nextMoveString;
-	else
-		moveString = this->moveString(move);
+	// The ponder search is over. Its move is ignored, and the
+	// engine can't be given a new position before it arrives.
+	if (m_ponderState == Pondering)
+	{
+		m_ponderState = StoppingPonder;
+		sendStop();
+		ping(false);
+	}
 
-	// If we're not in force mode, we'll have to wait for the
-	// 'go' command until the move can be sent to the engine.
-	if (!m_forceMode)
+	// TURN can only tell the engine about one opponent move. If
+	// more moves are made before the engine has to think (opening
+	// moves, or a book move of its own), the position is sent
+	// with BOARD instead.
+	if (!m_nextMove.isNull())
+		m_boardSynced = false;
+	if (!m_boardSynced)
 	{
-		if (m_nextMove.isNull())
-		{
-			m_nextMove = move;
-			m_nextMoveString = moveString;
-			return;
-		}
-		else if (move != m_nextMove) {
-			setForceMode(true);
-		}
+		m_nextMove = Chess::Move();
+		return;
 	}
 
-/*
-	if (m_ftUsermove)
-		write("usermove " + moveString);
-	else
-		write(moveString);
-*/
-	write("TURN " + moveString);
-	m_nextMove = Chess::Move();
+	m_nextMove = move;
+	m_nextMoveString = moveString(move);
 }
 
 void GomocupEngine::startThinking()
 {
-	setForceMode(false);
+	// The time and the position go out in one write
+	beginWriteBatch();
 	sendTimeLeft();
 
-	if (m_nextMove.isNull()) {
+	if (!m_boardSynced)
+	{
+		m_boardSynced = true;
+		setGomokuBoard(side());
+	}
+	else if (!m_nextMove.isNull())
+	{
+		write("TURN " + m_nextMoveString);
+		m_nextMove = Chess::Move();
+	}
+	else
 		write("BEGIN");
-	} else {
-		makeMove(m_nextMove);
+	endWriteBatch();
+}
+
+void GomocupEngine::startPondering()
+{
+	if (!pondering()
+	||  state() != Observing
+	||  m_ponderState != NotPondering
+	||  !isReady())
+		return;
+
+	// Search the position from the opponent's point of view
+	// within the opponent's time. The engine's view of the board
+	// is wrong after this, so its next turn starts with BOARD.
+	beginWriteBatch();
+	write(QString("INFO timeout_turn %1")
+	      .arg(turnTimeout(opponent()->timeControl())));
+	m_ponderTimeout = true;
+	m_boardSynced = false;
+	m_nextMove = Chess::Move();
+	m_ponderState = Pondering;
+	setGomokuBoard(side().opposite());
+	endWriteBatch();
+}
+
+bool GomocupEngine::supportsSwapOpening() const
+{
+	return true;
+}
+
+void GomocupEngine::startSwapThinking()
+{
+	beginWriteBatch();
+	sendTimeLeft();
+
+	// SWAP2BOARD lists the stones in the order they were placed,
+	// without colors. The opening stones are never sent with TURN,
+	// so the first move after the opening is sent with BOARD.
+	m_boardSynced = false;
+	m_nextMove = Chess::Move();
+	m_swapping = true;
+
+	write("SWAP2BOARD");
+	const QVector<Chess::Move> moves = board()->getHistoricalMoves();
+	for (const Chess::Move& move : moves)
+	{
+		const Chess::Square sq = board()->chessSquarePublic(move.targetSquare());
+		write(QString("%1,%2").arg(sq.file()).arg(sq.rank()));
 	}
+	write("DONE");
+	endWriteBatch();
+}
+
+bool GomocupEngine::isPondering() const
+{
+	return m_ponderState != NotPondering;
 }
 
 void GomocupEngine::onTimeout()
@@ -375,32 +560,54 @@ void GomocupEngine::setFeature(const QString& name, const QString& val)
 }
 */
 
-void GomocupEngine::setGomokuBoard() {
-
-	setForceMode(true);
-	write("BOARD");
+void GomocupEngine::setGomokuBoard(Chess::Side side)
+{
+	const int width = board()->width();
+	const int height = board()->height();
+	const QVector<Chess::Move> moves = board()->getHistoricalMoves();
+
+	QVector<Chess::Square> stones;
+	stones.reserve(moves.size());
+	QVector<bool> played(width * height, false);
+	for (const Chess::Move& move : moves)
+	{
+		const Chess::Square sq = board()->chessSquarePublic(move.targetSquare());
+		played[sq.rank() * width + sq.file()] = true;
+		stones << sq;
+	}
 
-	QVector<Chess::Move> moves = board()->getHistoricalMoves();
-	for (int i = 0; i < moves.size(); i++) {
-		
-		Chess::Move mv = moves[i];
-		Chess::Square sq = board()->chessSquarePublic(mv.targetSquare());
-		Chess::Piece pc = board()->pieceAt(sq);
-		
-		int pieceInt = 0;
-		if (pc.side() == Chess::Side::White) {
-			pieceInt = 2;
-		} else if (pc.side() == Chess::Side::Black) {
-			pieceInt = 1;
+	// Stones of the starting position come first, then the moves
+	// in the order they were played
+	QVector<Chess::Square> setup;
+	for (int rank = 0; rank < height; rank++)
+	{
+		for (int file = 0; file < width; file++)
+		{
+			const Chess::Square sq(file, rank);
+			if (!played[rank * width + file]
+			&&  !board()->pieceAt(sq).side().isNull())
+				setup << sq;
 		}
+	}
+	stones = setup + stones;
 
-		// set move
-		write(QString("%1,%2,%3").arg(sq.file()).arg(sq.rank()).arg(pieceInt));
+	if (stones.isEmpty())
+	{
+		write("BEGIN");
+		return;
 	}
 
+	// Field 1 is a stone of the side to play, 2 the other side's.
+	// The whole position is sent with one write.
+	beginWriteBatch();
+	write("BOARD");
+	for (const Chess::Square& sq : stones)
+	{
+		const int field = board()->pieceAt(sq).side() == side ? 1 : 2;
+		write(QString("%1,%2,%3").arg(sq.file()).arg(sq.rank()).arg(field));
+	}
 	write("DONE");
-	setForceMode(false);
-
+	endWriteBatch();
 }
 
 // shift assumed mate scores further out
@@ -429,13 +636,32 @@ int GomocupEngine::adaptScore(int score) const
 
 void GomocupEngine::parseLine(const QString& line)
 {
-	const QStringRef command(firstToken(line));
-	if (command.isEmpty())
-		return;
+	parseRawLine(line.toUtf8());
+}
 
-	if (command.at(0).isDigit() && 
-	    command.contains(","))	// engine response move
+void GomocupEngine::parseRawLine(const QByteArray& line)
+{
+	const GomocupReply reply(line);
+
+	switch (reply.type())
+	{
+	case GomocupReply::Coordinates:
 	{
+		// The result of a ponder search is never played
+		if (m_ponderState != NotPondering)
+		{
+			const bool stopping = (m_ponderState == StoppingPonder);
+			m_ponderState = NotPondering;
+			if (stopping)
+			{
+				pong();
+				// The game ended during the ponder search
+				if (state() == FinishingGame)
+					finishGame();
+			}
+			return;
+		}
+
 		if (state() != Thinking)
 		{
 			if (state() == FinishingGame)
@@ -446,82 +672,123 @@ void GomocupEngine::parseLine(const QString& line)
 			return;
 		}
 
-		const QString& movestr = *command.string();
-		Chess::Move move = board()->moveFromString(movestr);
-		if (move.isNull())
+		if (m_swapping)
 		{
-			std::cout << "Illegal move? " << movestr.toStdString() << std::endl;
-			forfeit(Chess::Result::IllegalMove, movestr);
+			parseSwapReply(reply);
 			return;
 		}
 
-		emitMove(move);
-	}
-	else if (command.contains("=")) // response to ABOUT
-	{
-		QStringRef ref(command);
-		
-		std::cout << "GetAbout[";
-		while (!ref.isNull()) {
-			std::cout << ref.toString().toStdString();
-			ref = nextToken(ref);
+		if (reply.count() > 1
+		||  reply.x() >= board()->width() || reply.y() >= board()->height())
+		{
+			forfeit(Chess::Result::IllegalMove, reply.text());
+			return;
 		}
-		std::cout << "]" << std::endl;
 
-		pong();
-	}
-	else if (command == "OK")
-	{
-		pong();
-	}
-	else if (command.startsWith("MESSAGE"))
-	{
-		QStringRef ref(command);
-		
-		std::cout << "GetMessage[";
-		while (!ref.isNull()) {
-			std::cout << ref.toString().toStdString();
-			ref = nextToken(ref);
+		const Chess::Square square(reply.x(), reply.y());
+		const Chess::Move move(board()->moveFromGenericMove(
+			Chess::GenericMove(square, square, Chess::Piece::WallPiece)));
+		if (!board()->isLegalMove(move))
+		{
+			forfeit(Chess::Result::IllegalMove, reply.text());
+			return;
 		}
-		std::cout << "]" << std::endl;
+		emitMove(move);
+		break;
 	}
-	else if (command.startsWith("DEBUG"))
-	{
-		QStringRef ref(command);
+	case GomocupReply::Swap:
+		if (state() == Thinking && m_swapping)
+			parseSwapReply(reply);
+		else
+			qWarning("Unexpected SWAP from %s", qUtf8Printable(name()));
+		break;
+	case GomocupReply::About:
+		ccTrace(lcGomocup).noquote() << name() << "->" << QString::fromUtf8(line);
 
-		std::cout << "GetDebug[";
-		while (!ref.isNull()) {
-			std::cout << ref.toString().toStdString();
-			ref = nextToken(ref);
+		if (state() == Starting)
+			initialize();
+		else
+			pong();
+		break;
+	case GomocupReply::Ok:
+		if (state() == Starting)
+			initialize();
+		else
+		{
+			m_restarting = false;
+			pong();
 		}
-		std::cout << "]" << std::endl;
-	}
-	else if (command == "ERROR")
-	{
-		QStringRef ref(command);
-		
-		std::cout << "GetError[";
-		while (!ref.isNull()) {
-			std::cout << ref.toString().toStdString();
-			ref = nextToken(ref);
+		break;
+	case GomocupReply::Message:
+	case GomocupReply::Debug:
+		ccTrace(lcGomocup).noquote() << name() << "->" << QString::fromUtf8(line);
+
+		if (state() == Thinking
+		&&  m_evalParser.isEnabled()
+		&&  m_evalParser.parse(reply.textData(), reply.textSize(), &m_eval))
+			emit thinking(m_eval);
+		break;
+	case GomocupReply::Error:
+	case GomocupReply::Unknown:
+		ccTrace(lcGomocup).noquote() << name() << "->" << QString::fromUtf8(line);
+
+		// An engine that doesn't know ABOUT is still listening
+		if (state() == Starting && reply.type() == GomocupReply::Unknown)
+			initialize();
+		// No RESTART support, start the game the old way and
+		// use a new process for the next game
+		else if (m_restarting)
+		{
+			m_restarting = false;
+			m_ftRestart = false;
+			sendStart();
 		}
-		std::cout << "]" << std::endl;
+		break;
+	default:
+		break;
 	}
-	else if (command == "UNKNOWN")
+}
+
+bool GomocupEngine::isDroppableLine(const QByteArray& line) const
+{
+	const GomocupReply::Type type = GomocupReply(line).type();
+	return type == GomocupReply::Message || type == GomocupReply::Debug;
+}
+
+void GomocupEngine::parseSwapReply(const GomocupReply& reply)
+{
+	m_swapping = false;
+
+	// The game checks the number of stones and their legality
+	QVector<Chess::Move> stones;
+	stones.reserve(reply.count());
+	for (int i = 0; i < reply.count(); i++)
 	{
-		QStringRef ref(command);
-		
-		std::cout << "GetUnknown[";
-		while (!ref.isNull()) {
-			std::cout << ref.toString().toStdString();
-			ref = nextToken(ref);
+		if (reply.x(i) >= board()->width() || reply.y(i) >= board()->height())
+		{
+			forfeit(Chess::Result::IllegalMove, reply.text());
+			return;
 		}
-		std::cout << "]" << std::endl;
+
+		const Chess::Square square(reply.x(i), reply.y(i));
+		stones << board()->moveFromGenericMove(
+			Chess::GenericMove(square, square, Chess::Piece::WallPiece));
 	}
 
+	emitSwapDecision(stones);
 }
 
 void GomocupEngine::sendOption(const QString& name, const QVariant& value)
 {
-	// TODO?
+	if (name == "memory")
+		write(QString("INFO max_memory %1")
+		      .arg(qint64(value.toInt()) * 1024 * 1024));
+	else if (name == "folder" && !value.toString().isEmpty())
+		write("INFO folder " + value.toString());
+	else if (name == "message keys" && !m_evalParser.setKeys(value.toString()))
+		qWarning("Invalid message keys for %s: %s",
+			 qUtf8Printable(this->name()),
+			 qUtf8Printable(value.toString()));
+	else if (name == "message rate")
+		setOutputRateLimit(value.toInt());
 }
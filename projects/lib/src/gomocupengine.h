@@ -19,7 +19,10 @@
 #ifndef GOMOCUPENGINE_H
 #define GOMOCUPENGINE_H
 
+#include <QElapsedTimer>
 #include "chessengine.h"
+#include "gomocupevalparser.h"
+#include "gomocupreply.h"
 #include "board/board.h"
 #include "board/square.h"
 #include "board/piece.h"
@@ -41,8 +44,17 @@ class LIB_EXPORT GomocupEngine : public ChessEngine
 		// Inherited from ChessEngine
 		virtual void endGame(const Chess::Result& result);
 		virtual void makeMove(const Chess::Move& move);
+		virtual void startPondering();
+		virtual bool supportsSwapOpening() const;
 		virtual QString protocol() const;
 
+		/*!
+		 * Returns the time in milliseconds it took the engine to
+		 * become ready after it was started, or -1 if it isn't
+		 * ready yet.
+		 */
+		int startupLatency() const;
+
 	protected:
 		// Inherited from ChessEngine
 		virtual bool sendPing();
@@ -51,9 +63,13 @@ class LIB_EXPORT GomocupEngine : public ChessEngine
 		virtual void startProtocol();
 		virtual void startGame();
 		virtual void startThinking();
+		virtual void startSwapThinking();
 		virtual void parseLine(const QString& line);
+		virtual void parseRawLine(const QByteArray& line);
+		virtual bool isDroppableLine(const QByteArray& line) const;
 		virtual void sendOption(const QString& name, const QVariant& value);
 		virtual bool restartsBetweenGames() const;
+		virtual bool isPondering() const;
 
 	protected slots:
 		// Inherited from ChessEngine
@@ -64,17 +80,43 @@ class LIB_EXPORT GomocupEngine : public ChessEngine
 		void initialize();
 
 	private:
+		enum PonderState
+		{
+			NotPondering,
+			Pondering,
+			StoppingPonder
+		};
+
 		//EngineOption* parseOption(const QString& line);
 		//void setFeature(const QString& name, const QString& val);
-		void setForceMode(bool enable);
+		/*!
+		 * Sends START (or RECTSTART for a rectangular board) with
+		 * the size of the current board.
+		 */
+		void sendStart();
+		/*!
+		 * Sends the INFO keys that stay the same for the whole
+		 * game: time limits, memory limit, game type, rule and
+		 * the engine's data folder.
+		 */
+		void sendGameInfo();
+		/*! Sends the time left on the engine's clock. */
 		void sendTimeLeft();
 		void finishGame();
 		QString moveString(const Chess::Move& move);
 		int adaptScore(int score) const;
-		void setGomokuBoard();
-		void sendTurnInfo();
+		/*!
+		 * Sends the current position with BOARD and lets the
+		 * engine play for \a side, or sends BEGIN if the board
+		 * is empty.
+		 */
+		void setGomokuBoard(Chess::Side side);
+		/*!
+		 * Parses the stones of a swap opening decision in
+		 * \a reply, and emits the decision.
+		 */
+		void parseSwapReply(const GomocupReply& reply);
 		
-		bool m_forceMode;
 		bool m_drawOnNextMove;
 		
 		// Engine features
@@ -85,13 +127,24 @@ class LIB_EXPORT GomocupEngine : public ChessEngine
 		bool m_ftUsermove;
 		bool m_ftReuse;
 		bool m_ftNps;
+		bool m_ftRestart;
 		
 		bool m_gotResult;
+		bool m_boardSynced;
+		bool m_restarting;
+		bool m_swapping;
+		int m_startWidth;
+		int m_startHeight;
+		PonderState m_ponderState;
+		bool m_ponderTimeout;
 		int m_lastPing;
 		Chess::Move m_nextMove;
 		QString m_nextMoveString;
 		Chess::Board::MoveNotation m_notation;
 		QTimer* m_initTimer;
+		QElapsedTimer m_startupTimer;
+		int m_startupLatency;
+		GomocupEvalParser m_evalParser;
 };
 
 #endif // XBOARDENGINE_H
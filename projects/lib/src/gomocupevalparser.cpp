@@ -0,0 +1,312 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gomocupevalparser.h"
+
+#include <QStringList>
+
+#include "moveevaluation.h"
+
+namespace {
+
+const char* const s_fieldNames[] = {
+	"depth", "score", "nodes", "nps", "time", "pv"
+};
+
+inline bool isSeparator(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == ','
+	    || c == ';' || c == '|' || c == ':' || c == '=';
+}
+
+inline bool isDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+inline char toLower(char c)
+{
+	return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+}
+
+/*
+ * Reads a non-negative decimal number with an optional fraction.
+ * Returns false if there are no digits at \a pos.
+ */
+bool readDecimal(const char* data, int* pos, int end, double* value)
+{
+	const int start = *pos;
+	double v = 0.0;
+	while (*pos < end && isDigit(data[*pos]))
+		v = v * 10.0 + (data[(*pos)++] - '0');
+	if (*pos < end && data[*pos] == '.')
+	{
+		double scale = 0.1;
+		for ((*pos)++; *pos < end && isDigit(data[*pos]); (*pos)++)
+		{
+			v += (data[*pos] - '0') * scale;
+			scale /= 10.0;
+		}
+	}
+	*value = v;
+	return *pos > start && isDigit(data[start]);
+}
+
+// Reads a count with an optional k, M or G suffix
+bool readCount(const char* data, int pos, int end, quint64* count)
+{
+	double value;
+	if (!readDecimal(data, &pos, end, &value))
+		return false;
+	if (pos < end)
+	{
+		switch (toLower(data[pos]))
+		{
+		case 'k':
+			value *= 1e3;
+			break;
+		case 'm':
+			value *= 1e6;
+			break;
+		case 'g':
+			value *= 1e9;
+			break;
+		default:
+			break;
+		}
+	}
+	*count = quint64(value + 0.5);
+	return true;
+}
+
+// Reads a depth with an optional selective depth ("12-20" or "12/20")
+bool readDepth(const char* data, int pos, int end, int* depth, int* selDepth)
+{
+	double value;
+	if (!readDecimal(data, &pos, end, &value))
+		return false;
+	*depth = int(value);
+	*selDepth = 0;
+	if (pos < end && (data[pos] == '-' || data[pos] == '/'))
+	{
+		pos++;
+		if (readDecimal(data, &pos, end, &value))
+			*selDepth = int(value);
+	}
+	return true;
+}
+
+// Reads a score, or a mate distance such as "M5", "+M5" or "-M4"
+bool readScore(const char* data, int pos, int end, int* score)
+{
+	bool negative = false;
+	if (pos < end && (data[pos] == '-' || data[pos] == '+'))
+		negative = data[pos++] == '-';
+
+	const bool mate = pos < end && toLower(data[pos]) == 'm';
+	if (mate)
+		pos++;
+
+	double value;
+	if (!readDecimal(data, &pos, end, &value))
+		return false;
+
+	int v = int(value);
+	if (mate)
+		v = MoveEvaluation::MATE_SCORE - v;
+	*score = negative ? -v : v;
+	return true;
+}
+
+// Reads a time in milliseconds, or in seconds with an "s" suffix
+bool readTime(const char* data, int pos, int end, int* time)
+{
+	double value;
+	if (!readDecimal(data, &pos, end, &value))
+		return false;
+	if (pos < end && toLower(data[pos]) == 's')
+		value *= 1000.0;
+	*time = int(value + 0.5);
+	return true;
+}
+
+} // anonymous namespace
+
+const char* const GomocupEvalParser::DefaultKeys =
+	"depth=depth,d;score=ev,eval,score,val;nodes=n,nodes;"
+	"nps=nps,speed;time=tm,time;pv=pv,bestline";
+
+GomocupEvalParser::GomocupEvalParser()
+{
+	setKeys(DefaultKeys);
+}
+
+bool GomocupEvalParser::setKeys(const QString& keys)
+{
+	QList<Key> newKeys;
+
+	const QStringList fields = keys.split(';', QString::SkipEmptyParts);
+	for (const QString& field : fields)
+	{
+		const int eq = field.indexOf('=');
+		if (eq < 0)
+			return false;
+
+		const QString name = field.left(eq).trimmed().toLower();
+		int f = 0;
+		while (f < FieldCount && name != s_fieldNames[f])
+			f++;
+		if (f == FieldCount)
+			return false;
+
+		const QStringList aliases = field.mid(eq + 1).split(',', QString::SkipEmptyParts);
+		for (const QString& alias : aliases)
+		{
+			const QByteArray key = alias.trimmed().toLower().toLatin1();
+			if (key.isEmpty())
+				continue;
+			for (const char c : key)
+			{
+				if (isSeparator(c) || isDigit(c))
+					return false;
+			}
+			newKeys.append(Key { key, Field(f) });
+		}
+	}
+
+	m_keys = newKeys;
+	return true;
+}
+
+bool GomocupEvalParser::isEnabled() const
+{
+	return !m_keys.isEmpty();
+}
+
+int GomocupEvalParser::findField(const char* data, int size) const
+{
+	for (const Key& key : m_keys)
+	{
+		if (key.name.size() != size)
+			continue;
+
+		int i = 0;
+		while (i < size && toLower(data[i]) == key.name.at(i))
+			i++;
+		if (i == size)
+			return key.field;
+	}
+
+	return -1;
+}
+
+bool GomocupEvalParser::parse(const char* data, int size, MoveEvaluation* eval) const
+{
+	Q_ASSERT(eval != nullptr);
+
+	bool found = false;
+	int pos = 0;
+	while (pos < size)
+	{
+		// Next word
+		while (pos < size && isSeparator(data[pos]))
+			pos++;
+		const int wordStart = pos;
+		while (pos < size && !isSeparator(data[pos]))
+			pos++;
+		if (pos == wordStart)
+			break;
+
+		const int field = findField(data + wordStart, pos - wordStart);
+		if (field < 0)
+			continue;
+
+		// Its value
+		while (pos < size && isSeparator(data[pos]) && data[pos] != '|')
+			pos++;
+		const int valueStart = pos;
+
+		if (field == Pv)
+		{
+			while (pos < size && data[pos] != '|')
+				pos++;
+			int valueEnd = pos;
+			while (valueEnd > valueStart && isSeparator(data[valueEnd - 1]))
+				valueEnd--;
+			if (valueEnd > valueStart)
+			{
+				eval->setPv(QString::fromLatin1(data + valueStart,
+								valueEnd - valueStart));
+				found = true;
+			}
+			continue;
+		}
+
+		while (pos < size && !isSeparator(data[pos]))
+			pos++;
+
+		int depth;
+		int selDepth;
+		int value;
+		quint64 count;
+		switch (field)
+		{
+		case Depth:
+			if (readDepth(data, valueStart, pos, &depth, &selDepth))
+			{
+				eval->setDepth(depth);
+				if (selDepth > 0)
+					eval->setSelectiveDepth(selDepth);
+				found = true;
+			}
+			break;
+		case Score:
+			if (readScore(data, valueStart, pos, &value))
+			{
+				eval->setScore(value);
+				found = true;
+			}
+			break;
+		case Nodes:
+			if (readCount(data, valueStart, pos, &count))
+			{
+				eval->setNodeCount(count);
+				found = true;
+			}
+			break;
+		case Nps:
+			if (readCount(data, valueStart, pos, &count))
+			{
+				eval->setNps(count);
+				found = true;
+			}
+			break;
+		case Time:
+			if (readTime(data, valueStart, pos, &value))
+			{
+				eval->setTime(value);
+				found = true;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	return found;
+}
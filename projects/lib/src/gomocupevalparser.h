@@ -0,0 +1,96 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GOMOCUPEVALPARSER_H
+#define GOMOCUPEVALPARSER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+class MoveEvaluation;
+
+/*!
+ * \brief Reads search information from Gomocup MESSAGE lines
+ *
+ * The Gomocup protocol has no standard format for search output, but
+ * most engines print a list of keys and values, for example
+ * "depth 12-20 ev 345 n 1.2M nps 850k tm 1500 pv h8 i9". The keys
+ * that mean the same thing differ from engine to engine, so they are
+ * configured with a key string of the form
+ * "field=key1,key2;field=key3", where field is one of depth, score,
+ * nodes, nps, time and pv. Keys are case-insensitive.
+ *
+ * Values can have a k, M or G suffix (1.2M), a depth can include the
+ * selective depth (12-20), a score can be a mate distance (M5 or
+ * -M4) and a time can be given in seconds (1.5s). The value of a pv
+ * key is the rest of the line up to the next '|'.
+ *
+ * The parser works on the raw bytes of the line and creates strings
+ * only for the principal variation.
+ */
+class LIB_EXPORT GomocupEvalParser
+{
+	public:
+		/*! The key string used by default. */
+		static const char* const DefaultKeys;
+
+		/*! Creates a parser that uses DefaultKeys. */
+		GomocupEvalParser();
+
+		/*!
+		 * Sets the keys to \a keys.
+		 *
+		 * An empty string disables the parser. Returns false,
+		 * and keeps the old keys, if \a keys is not valid.
+		 */
+		bool setKeys(const QString& keys);
+		/*! Returns true if the parser has any keys. */
+		bool isEnabled() const;
+
+		/*!
+		 * Reads the values in the \a size bytes at \a data into
+		 * \a eval. The score is from the engine's point of view.
+		 *
+		 * Returns true if at least one value was read.
+		 */
+		bool parse(const char* data, int size, MoveEvaluation* eval) const;
+
+	private:
+		enum Field
+		{
+			Depth,
+			Score,
+			Nodes,
+			Nps,
+			Time,
+			Pv,
+			FieldCount
+		};
+		struct Key
+		{
+			QByteArray name;
+			Field field;
+		};
+
+		int findField(const char* data, int size) const;
+
+		QList<Key> m_keys;
+};
+
+#endif // GOMOCUPEVALPARSER_H
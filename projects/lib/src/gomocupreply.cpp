@@ -0,0 +1,218 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gomocupreply.h"
+
+#include <cstring>
+
+namespace {
+
+// Longer numbers can't be coordinates on any board
+const int MaxDigits = 5;
+
+inline bool isSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline bool isDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+inline int skipSpace(const char* data, int pos, int size)
+{
+	while (pos < size && isSpace(data[pos]))
+		pos++;
+	return pos;
+}
+
+// Reads a non-negative number or returns -1
+int readNumber(const char* data, int* pos, int size)
+{
+	const int start = *pos;
+	int value = 0;
+	while (*pos < size && isDigit(data[*pos]) && *pos - start < MaxDigits)
+		value = value * 10 + (data[(*pos)++] - '0');
+
+	if (*pos == start || (*pos < size && isDigit(data[*pos])))
+		return -1;
+	return value;
+}
+
+struct Keyword
+{
+	const char* name;
+	int length;
+	GomocupReply::Type type;
+};
+
+const Keyword s_keywords[] = {
+	{ "OK", 2, GomocupReply::Ok },
+	{ "MESSAGE", 7, GomocupReply::Message },
+	{ "DEBUG", 5, GomocupReply::Debug },
+	{ "UNKNOWN", 7, GomocupReply::Unknown },
+	{ "ERROR", 5, GomocupReply::Error },
+	{ "SUGGEST", 7, GomocupReply::Suggest },
+	{ "SWAP", 4, GomocupReply::Swap }
+};
+
+} // anonymous namespace
+
+GomocupReply::GomocupReply()
+	: m_type(Empty),
+	  m_count(0),
+	  m_textStart(0),
+	  m_textEnd(0)
+{
+}
+
+GomocupReply::GomocupReply(const QByteArray& line)
+	: m_line(line),
+	  m_type(Empty),
+	  m_count(0),
+	  m_textStart(0),
+	  m_textEnd(0)
+{
+	const char* data = m_line.constData();
+	const int size = m_line.size();
+
+	int end = size;
+	while (end > 0 && isSpace(data[end - 1]))
+		end--;
+	const int pos = skipSpace(data, 0, end);
+	if (pos == end)
+		return;
+
+	m_textStart = pos;
+	m_textEnd = end;
+
+	// Fast path for the move reply
+	if (isDigit(data[pos]))
+	{
+		m_type = parseCoordinates(pos, MaxCoordinates) ? Coordinates : Other;
+		return;
+	}
+
+	parseKeyword(pos);
+}
+
+void GomocupReply::parseKeyword(int pos)
+{
+	const char* data = m_line.constData();
+
+	int wordEnd = pos;
+	while (wordEnd < m_textEnd && !isSpace(data[wordEnd]))
+		wordEnd++;
+	const int length = wordEnd - pos;
+
+	for (const Keyword& keyword : s_keywords)
+	{
+		if (keyword.length != length
+		||  std::memcmp(data + pos, keyword.name, length) != 0)
+			continue;
+
+		m_type = keyword.type;
+		m_textStart = skipSpace(data, wordEnd, m_textEnd);
+		if (m_type == Suggest && !parseCoordinates(m_textStart, 1))
+			m_type = Other;
+		return;
+	}
+
+	// The answer to ABOUT is a list of key="value" pairs
+	if (std::memchr(data + pos, '=', m_textEnd - pos) != nullptr)
+		m_type = About;
+	else
+		m_type = Other;
+}
+
+bool GomocupReply::parseCoordinates(int pos, int maxCount)
+{
+	const char* data = m_line.constData();
+
+	int count = 0;
+	while (count < maxCount)
+	{
+		const int x = readNumber(data, &pos, m_textEnd);
+		if (x < 0)
+			return false;
+		pos = skipSpace(data, pos, m_textEnd);
+		if (pos >= m_textEnd || data[pos] != ',')
+			return false;
+		pos = skipSpace(data, pos + 1, m_textEnd);
+		const int y = readNumber(data, &pos, m_textEnd);
+		if (y < 0)
+			return false;
+
+		m_x[count] = x;
+		m_y[count] = y;
+		count++;
+
+		// The moves are separated by whitespace
+		if (pos == m_textEnd)
+		{
+			m_count = count;
+			return true;
+		}
+		if (!isSpace(data[pos]))
+			return false;
+		pos = skipSpace(data, pos, m_textEnd);
+	}
+
+	return false;
+}
+
+GomocupReply::Type GomocupReply::type() const
+{
+	return m_type;
+}
+
+int GomocupReply::count() const
+{
+	return m_count;
+}
+
+int GomocupReply::x(int i) const
+{
+	if (i < 0 || i >= m_count)
+		return -1;
+	return m_x[i];
+}
+
+int GomocupReply::y(int i) const
+{
+	if (i < 0 || i >= m_count)
+		return -1;
+	return m_y[i];
+}
+
+const char* GomocupReply::textData() const
+{
+	return m_line.constData() + m_textStart;
+}
+
+int GomocupReply::textSize() const
+{
+	return m_textEnd - m_textStart;
+}
+
+QString GomocupReply::text() const
+{
+	return QString::fromUtf8(m_line.constData() + m_textStart,
+				 m_textEnd - m_textStart);
+}
@@ -0,0 +1,116 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GOMOCUPREPLY_H
+#define GOMOCUPREPLY_H
+
+#include <QByteArray>
+#include <QString>
+
+/*!
+ * \brief A line of output from a Gomocup engine
+ *
+ * The line is parsed byte by byte without creating any strings.
+ * Move replies ("x,y") are recognized first because they are the
+ * only replies whose parsing time counts against the engine's clock.
+ * The text of MESSAGE, DEBUG and similar replies is only decoded
+ * when text() is called.
+ *
+ * A Coordinates reply can have up to three moves ("x1,y1 x2,y2
+ * x3,y3"), which only happens in a swap opening.
+ *
+ * The reply shares the data of the line it was created from, so
+ * copying it doesn't allocate memory.
+ */
+class LIB_EXPORT GomocupReply
+{
+	public:
+		/*! The maximum number of moves in a Coordinates reply. */
+		static const int MaxCoordinates = 3;
+
+		/*! The type of a reply. */
+		enum Type
+		{
+			Empty,		//!< Only whitespace
+			Coordinates,	//!< One or more moves: "x,y"
+			Ok,		//!< "OK"
+			Unknown,	//!< "UNKNOWN [text]"
+			Error,		//!< "ERROR [text]"
+			Message,	//!< "MESSAGE [text]"
+			Debug,		//!< "DEBUG [text]"
+			Suggest,	//!< "SUGGEST x,y"
+			Swap,		//!< "SWAP" in a swap opening
+			About,		//!< Answer to ABOUT: key="value", ...
+			Other		//!< Anything else
+		};
+
+		/*! Creates an empty reply. */
+		GomocupReply();
+		/*!
+		 * Parses \a line. The line must not end with a newline
+		 * character.
+		 */
+		explicit GomocupReply(const QByteArray& line);
+
+		/*! Returns the type of the reply. */
+		Type type() const;
+		/*!
+		 * Returns the number of moves in a Coordinates or Suggest
+		 * reply, or 0 for other replies.
+		 */
+		int count() const;
+		/*!
+		 * Returns the x coordinate (file) of move \a i of a
+		 * Coordinates or Suggest reply, or -1 if there's no such
+		 * move.
+		 */
+		int x(int i = 0) const;
+		/*!
+		 * Returns the y coordinate (rank) of move \a i of a
+		 * Coordinates or Suggest reply, or -1 if there's no such
+		 * move.
+		 */
+		int y(int i = 0) const;
+		/*!
+		 * Returns the text of the reply without leading and
+		 * trailing whitespace.
+		 *
+		 * For replies that start with a keyword the keyword is
+		 * not included. For About and Other replies the text is
+		 * the whole line.
+		 */
+		QString text() const;
+		/*! Returns a pointer to the undecoded bytes of text(). */
+		const char* textData() const;
+		/*! Returns the number of bytes in textData(). */
+		int textSize() const;
+
+	private:
+		void parseKeyword(int pos);
+		bool parseCoordinates(int pos, int maxCount);
+
+		QByteArray m_line;
+		Type m_type;
+		int m_count;
+		int m_x[MaxCoordinates];
+		int m_y[MaxCoordinates];
+		int m_textStart;
+		int m_textEnd;
+};
+
+#endif // GOMOCUPREPLY_H
@@ -54,7 +54,9 @@ QTextStream& operator<<(QTextStream& out, const PgnGame& game)
 PgnGame::PgnGame()
 	: m_startingSide(Chess::Side::White),
 	  m_eco(EcoNode::root()),
-	  m_tagReceiver(nullptr)
+	  m_tagReceiver(nullptr),
+	  m_boardWidth(0),
+	  m_boardHeight(0)
 {
 }
 
@@ -145,7 +147,11 @@ Chess::Board* PgnGame::createBoard() const
 	}
 
 	// set board size for gomoku
-	board->setSize(boardSize());
+	if (m_boardWidth > 0 && m_boardHeight > 0)
+	{
+		board->setWidth(m_boardWidth);
+		board->setHeight(m_boardHeight);
+	}
 
 	return board;
 }
@@ -586,10 +592,15 @@ QMap< int, int > PgnGame::extractScores() const
 	return scores;
 }
 
-int PgnGame::boardSize() const {
-	return m_boardSize;
+int PgnGame::boardWidth() const {
+	return m_boardWidth;
+}
+
+int PgnGame::boardHeight() const {
+	return m_boardHeight;
 }
 
-void PgnGame::setBoardSize(int size) {
-	m_boardSize = size;
+void PgnGame::setBoardSize(int width, int height) {
+	m_boardWidth = width;
+	m_boardHeight = height;
 }
@@ -158,7 +158,16 @@ class LIB_EXPORT PgnGame
 		/*! Returns the starting position's FEN string. */
 		QString startingFenString() const;
 
-		int boardSize() const;
+		/*!
+		 * Returns the width of the board, or 0 if the variant's
+		 * default size is used.
+		 */
+		int boardWidth() const;
+		/*!
+		 * Returns the height of the board, or 0 if the variant's
+		 * default size is used.
+		 */
+		int boardHeight() const;
 
 		/*!
 		 * Sets \a tag's value to \a value.
@@ -184,7 +193,8 @@ class LIB_EXPORT PgnGame
 		/*! Sets the starting position's FEN string. */
 		void setStartingFenString(Chess::Side side, const QString& fen);
 
-		void setBoardSize(int size);
+		/*! Sets the board size to \a width x \a height squares. */
+		void setBoardSize(int width, int height);
 		/*!
 		 * Sets a description for the result.
 		 *
@@ -220,7 +230,8 @@ class LIB_EXPORT PgnGame
 		QString m_initialComment;
 		static QString timeStamp(const QDateTime& dateTime);
 		QDateTime m_gameStartTime;
-		int m_boardSize;
+		int m_boardWidth;
+		int m_boardHeight;
 };
 
 /*! Reads a PGN game from a PGN stream. */
@@ -61,6 +61,10 @@ class LIB_EXPORT PlayerBuilder
 		 * \param parent The player's parent object.
 		 * \param error If an error occurs and \a error is not 0, the error
 		 *              description is written here.
+		 *
+		 * The player may still be starting when this function returns.
+		 * It emits the ready() signal when it's ready to play, and the
+		 * disconnected() signal if it can't be started.
 		 */
 		virtual ChessPlayer* create(QObject* receiver,
 					    const char* method,
@@ -0,0 +1,145 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "playerpool.h"
+#include "chessplayer.h"
+
+PlayerPool::PlayerPool(QObject* parent)
+	: QObject(parent),
+	  m_capacity(0),
+	  m_clearing(false)
+{
+}
+
+int PlayerPool::count() const
+{
+	return m_players.size();
+}
+
+bool PlayerPool::isEmpty() const
+{
+	return m_players.isEmpty() && m_quittingPlayers.isEmpty();
+}
+
+int PlayerPool::capacity() const
+{
+	return m_capacity;
+}
+
+void PlayerPool::setCapacity(int capacity)
+{
+	m_capacity = qMax(capacity, 0);
+	evictPlayers();
+}
+
+ChessPlayer* PlayerPool::take(const PlayerBuilder* builder)
+{
+	Q_ASSERT(builder != nullptr);
+
+	for (int i = 0; i < m_players.size(); i++)
+	{
+		if (m_players.at(i).first != builder)
+			continue;
+
+		ChessPlayer* player = m_players.takeAt(i).second;
+		disconnect(player, nullptr, this, nullptr);
+		player->setParent(nullptr);
+		return player;
+	}
+
+	return nullptr;
+}
+
+void PlayerPool::add(const PlayerBuilder* builder, ChessPlayer* player)
+{
+	Q_ASSERT(builder != nullptr);
+	Q_ASSERT(player != nullptr);
+	Q_ASSERT(player->thread() == thread());
+
+	if (player->state() == ChessPlayer::Disconnected)
+	{
+		player->deleteLater();
+		return;
+	}
+
+	player->setParent(this);
+	connect(player, SIGNAL(disconnected()),
+		this, SLOT(onPlayerDisconnected()));
+	m_players.append(qMakePair(builder, player));
+	evictPlayers();
+}
+
+void PlayerPool::evictPlayers()
+{
+	if (m_capacity <= 0)
+		return;
+
+	// The oldest players are the least likely to play again soon
+	while (m_players.size() > m_capacity)
+	{
+		ChessPlayer* player = m_players.takeFirst().second;
+		m_quittingPlayers.append(player);
+		player->quit();
+	}
+}
+
+void PlayerPool::clear()
+{
+	const auto players = m_players;
+	m_players.clear();
+	for (const auto& entry : players)
+		m_quittingPlayers.append(entry.second);
+
+	if (m_quittingPlayers.isEmpty())
+	{
+		emit cleared();
+		return;
+	}
+	m_clearing = true;
+
+	// A player can disconnect right away
+	for (const auto& entry : players)
+		entry.second->quit();
+}
+
+void PlayerPool::onPlayerDisconnected()
+{
+	ChessPlayer* player = qobject_cast<ChessPlayer*>(QObject::sender());
+	Q_ASSERT(player != nullptr);
+
+	player->deleteLater();
+	if (m_quittingPlayers.removeOne(player))
+	{
+		if (m_clearing && m_quittingPlayers.isEmpty())
+		{
+			m_clearing = false;
+			emit cleared();
+		}
+		return;
+	}
+
+	// A crashed engine
+	for (int i = 0; i < m_players.size(); i++)
+	{
+		if (m_players.at(i).second == player)
+		{
+			m_players.removeAt(i);
+			break;
+		}
+	}
+}
@@ -0,0 +1,111 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLAYERPOOL_H
+#define PLAYERPOOL_H
+
+#include <QObject>
+#include <QList>
+#include <QPair>
+class ChessPlayer;
+class PlayerBuilder;
+
+/*!
+ * \brief A pool of idle players waiting for new games
+ *
+ * When a game thread is cleaned up, GameManager hands its players
+ * over to the pool instead of terminating them. A new game thread
+ * that needs a player from the same builder takes it from the pool,
+ * so an engine process is started and initialized only once even
+ * if it plays against many different opponents.
+ *
+ * The pooled players live in the pool's thread and are children
+ * of the pool. A player that disconnects while waiting in the pool
+ * is deleted. If the pool holds more players than its capacity(),
+ * the players that have waited the longest are terminated.
+ *
+ * \note The players are identified by their PlayerBuilder objects,
+ * so the builders must outlive the pool's players.
+ *
+ * \sa GameManager
+ */
+class LIB_EXPORT PlayerPool : public QObject
+{
+	Q_OBJECT
+
+	public:
+		/*! Creates a new empty pool. */
+		PlayerPool(QObject* parent = nullptr);
+
+		/*! Returns the number of idle players in the pool. */
+		int count() const;
+		/*!
+		 * Returns true if the pool has no idle players and isn't
+		 * waiting for any player to quit.
+		 */
+		bool isEmpty() const;
+
+		/*!
+		 * Returns the maximum number of idle players, or 0 if the
+		 * number is unlimited (the default).
+		 */
+		int capacity() const;
+		/*!
+		 * Sets the maximum number of idle players to \a capacity.
+		 * Players over the limit are terminated right away.
+		 */
+		void setCapacity(int capacity);
+
+		/*!
+		 * Removes a player created by \a builder from the pool and
+		 * returns it, or returns 0 if there is no such player.
+		 *
+		 * The returned player has no parent, and the caller is
+		 * responsible for moving it to the right thread.
+		 */
+		ChessPlayer* take(const PlayerBuilder* builder);
+		/*!
+		 * Adds \a player, created by \a builder, to the pool.
+		 *
+		 * \a player must live in the pool's thread and have no
+		 * parent. A disconnected player is deleted instead.
+		 */
+		void add(const PlayerBuilder* builder, ChessPlayer* player);
+		/*!
+		 * Terminates all idle players. The cleared() signal is
+		 * emitted when they are all gone.
+		 */
+		void clear();
+
+	signals:
+		/*! Emitted when the players terminated by clear() are gone. */
+		void cleared();
+
+	private slots:
+		void onPlayerDisconnected();
+
+	private:
+		void evictPlayers();
+
+		int m_capacity;
+		bool m_clearing;
+		QList< QPair<const PlayerBuilder*, ChessPlayer*> > m_players;
+		QList<ChessPlayer*> m_quittingPlayers;
+};
+
+#endif // PLAYERPOOL_H
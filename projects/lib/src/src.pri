@@ -4,6 +4,7 @@ DEPENDPATH += $$PWD
 HEADERS += $$PWD/chessengine.h \
     $$PWD/chessgame.h \
     $$PWD/chessplayer.h \
+    $$PWD/cpuaffinity.h \
     $$PWD/engineconfiguration.h \
     $$PWD/openingbook.h \
     $$PWD/pgnstream.h \
@@ -13,6 +14,8 @@ HEADERS += $$PWD/chessengine.h \
     $$PWD/uciengine.h \
     $$PWD/xboardengine.h \
     $$PWD/gomocupengine.h \
+    $$PWD/gomocupevalparser.h \
+    $$PWD/gomocupreply.h \
     $$PWD/moveevaluation.h \
     $$PWD/enginemanager.h \
     $$PWD/humanplayer.h \
@@ -24,7 +27,9 @@ HEADERS += $$PWD/chessengine.h \
     $$PWD/enginebuttonoption.h \
     $$PWD/pgngameentry.h \
     $$PWD/gamemanager.h \
+    $$PWD/concurrencycontroller.h \
     $$PWD/playerbuilder.h \
+    $$PWD/playerpool.h \
     $$PWD/enginebuilder.h \
     $$PWD/classregistry.h \
     $$PWD/enginefactory.h \
@@ -46,10 +51,12 @@ HEADERS += $$PWD/chessengine.h \
     $$PWD/pyramidtournament.h \
     $$PWD/tournamentplayer.h \
     $$PWD/tournamentpair.h \
+    $$PWD/trace.h \
     $$PWD/worker.h
 SOURCES += $$PWD/chessengine.cpp \
     $$PWD/chessgame.cpp \
     $$PWD/chessplayer.cpp \
+    $$PWD/cpuaffinity.cpp \
     $$PWD/engineconfiguration.cpp \
     $$PWD/openingbook.cpp \
     $$PWD/pgnstream.cpp \
@@ -59,6 +66,8 @@ SOURCES += $$PWD/chessengine.cpp \
     $$PWD/uciengine.cpp \
     $$PWD/xboardengine.cpp \
     $$PWD/gomocupengine.cpp \
+    $$PWD/gomocupevalparser.cpp \
+    $$PWD/gomocupreply.cpp \
     $$PWD/moveevaluation.cpp \
     $$PWD/enginemanager.cpp \
     $$PWD/humanplayer.cpp \
@@ -70,7 +79,9 @@ SOURCES += $$PWD/chessengine.cpp \
     $$PWD/enginebuttonoption.cpp \
     $$PWD/pgngameentry.cpp \
     $$PWD/gamemanager.cpp \
+    $$PWD/concurrencycontroller.cpp \
     $$PWD/playerbuilder.cpp \
+    $$PWD/playerpool.cpp \
     $$PWD/enginebuilder.cpp \
     $$PWD/enginefactory.cpp \
     $$PWD/humanbuilder.cpp \
@@ -91,6 +102,7 @@ SOURCES += $$PWD/chessengine.cpp \
     $$PWD/pyramidtournament.cpp \
     $$PWD/tournamentplayer.cpp \
     $$PWD/tournamentpair.cpp \
+    $$PWD/trace.cpp \
     $$PWD/worker.cpp
 win32 { 
     HEADERS += $$PWD/engineprocess_win.h \
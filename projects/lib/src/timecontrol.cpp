@@ -22,6 +22,10 @@
 
 namespace {
 
+// Number of moves the time is divided between when the time
+// control doesn't say how many moves are left
+const int SuddenDeathMoves = 30;
+
 QString s_timeString(int ms)
 {
 	if (ms == 0 || ms % 60000 != 0)
@@ -52,6 +56,7 @@ TimeControl::TimeControl()
 	  m_plyLimit(0),
 	  m_nodeLimit(0),
 	  m_lastMoveTime(0),
+	  m_lastMoveBudget(0),
 	  m_expiryMargin(0),
 	  m_expired(false),
 	  m_infinite(false)
@@ -68,6 +73,7 @@ TimeControl::TimeControl(const QString& str)
 	  m_plyLimit(0),
 	  m_nodeLimit(0),
 	  m_lastMoveTime(0),
+	  m_lastMoveBudget(0),
 	  m_expiryMargin(0),
 	  m_expired(false),
 	  m_infinite(false)
@@ -199,6 +205,7 @@ void TimeControl::initialize()
 {
 	m_expired = false;
 	m_lastMoveTime = 0;
+	m_lastMoveBudget = 0;
 
 	if (m_timePerTc != 0)
 	{
@@ -333,6 +340,20 @@ void TimeControl::update(bool applyIncrement)
 	else
 		m_lastMoveTime = 0;
 
+	// The share of the clock that was meant for this move
+	if (m_infinite)
+		m_lastMoveBudget = 0;
+	else if (m_timePerMove != 0)
+		m_lastMoveBudget = m_timePerMove;
+	else
+	{
+		int movesLeft = m_movesPerTc > 0 ? m_movesLeft : SuddenDeathMoves;
+		int budget = m_timeLeft / qMax(movesLeft, 1);
+		if (applyIncrement)
+			budget += m_increment;
+		m_lastMoveBudget = qMin(budget, m_timeLeft);
+	}
+
 	if (!m_infinite && m_lastMoveTime > m_timeLeft + m_expiryMargin)
 		m_expired = true;
 
@@ -364,6 +385,11 @@ int TimeControl::lastMoveTime() const
 	return m_lastMoveTime;
 }
 
+int TimeControl::lastMoveBudget() const
+{
+	return m_lastMoveBudget;
+}
+
 bool TimeControl::expired() const
 {
 	return m_expired;
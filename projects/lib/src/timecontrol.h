@@ -185,6 +185,16 @@ class LIB_EXPORT TimeControl
 
 		/*! Returns the last elapsed move time. */
 		int lastMoveTime() const;
+		/*!
+		 * Returns the time that was allotted to the last move:
+		 * the time per move, or the time left on the clock divided
+		 * by the number of moves left plus the increment. Sudden
+		 * death time controls divide the time between 30 moves.
+		 * Returns 0 if the time was infinite.
+		 *
+		 * \sa lastMoveTime()
+		 */
+		int lastMoveBudget() const;
 
 		/*! Returns true if the allotted time has expired. */
 		bool expired() const;
@@ -214,6 +224,7 @@ class LIB_EXPORT TimeControl
 		int m_plyLimit;
 		qint64 m_nodeLimit;
 		int m_lastMoveTime;
+		int m_lastMoveBudget;
 		int m_expiryMargin;
 		bool m_expired;
 		bool m_infinite;
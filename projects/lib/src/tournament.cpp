@@ -20,6 +20,7 @@
 #include <QFile>
 #include <QMultiMap>
 #include <QSet>
+#include <algorithm>
 #include "gamemanager.h"
 #include "playerbuilder.h"
 #include "board/boardfactory.h"
@@ -45,11 +46,13 @@ Tournament::Tournament(GameManager* gameManager, QObject *parent)
 	  m_gamesPerEncounter(1),
 	  m_roundMultiplier(1),
 	  m_startDelay(0),
+	  m_lookahead(0),
 	  m_openingDepth(1024),
 	  m_seedCount(0),
 	  m_stopping(false),
 	  m_openingRepetitions(1),
 	  m_openingPolicy(DefaultPolicy),
+	  m_swapOpening(ChessGame::NoSwapOpening),
 	  m_recover(false),
 	  m_pgnCleanup(true),
 	  m_pgnWriteUnfinishedGames(true),
@@ -61,7 +64,8 @@ Tournament::Tournament(GameManager* gameManager, QObject *parent)
 	  m_swapSides(true),
 	  m_pgnOutMode(PgnGame::Verbose),
 	  m_pair(nullptr),
-		m_customizedBoardSize(-1)
+	  m_boardWidth(-1),
+	  m_boardHeight(-1)
 {
 	Q_ASSERT(gameManager != nullptr);
 }
@@ -72,6 +76,7 @@ Tournament::~Tournament()
 		qWarning("Tournament: Destroyed while games are still running.");
 
 	qDeleteAll(m_gameData);
+	discardPreparedGames();
 	qDeleteAll(m_pairs);
 
 	QSet<const OpeningBook*> books;
@@ -220,6 +225,17 @@ void Tournament::setStartDelay(int delay)
 	m_startDelay = delay;
 }
 
+int Tournament::lookahead() const
+{
+	return m_lookahead;
+}
+
+void Tournament::setLookahead(int games)
+{
+	Q_ASSERT(games >= 0);
+	m_lookahead = games;
+}
+
 void Tournament::setRecoveryMode(bool recover)
 {
 	m_recover = recover;
@@ -290,15 +306,21 @@ void Tournament::setSwapSides(bool enabled)
 	m_swapSides = enabled;
 }
 
+void Tournament::setSwapOpening(ChessGame::SwapOpening rule)
+{
+	m_swapOpening = rule;
+}
+
 void Tournament::setOpeningBookOwnership(bool enabled)
 {
 	m_bookOwnership = enabled;
 }
 
-void Tournament::setBoardSize(int sz)
+void Tournament::setBoardSize(int width, int height)
 {
-	Q_ASSERT(sz > 4 && sz < 32);
-	m_customizedBoardSize = sz;
+	Q_ASSERT(width > 4 && height > 4);
+	m_boardWidth = width;
+	m_boardHeight = height;
 }
 
 void Tournament::addPlayer(PlayerBuilder* builder,
@@ -350,6 +372,11 @@ bool Tournament::hasGauntletRatingsOrder() const
 }
 
 void Tournament::startGame(TournamentPair* pair)
+{
+	launchGame(prepareGame(pair));
+}
+
+Tournament::PreparedGame Tournament::prepareGame(TournamentPair* pair)
 {
 	Q_ASSERT(pair->isValid());
 	m_pair = pair;
@@ -362,17 +389,13 @@ void Tournament::startGame(TournamentPair* pair)
 	Q_ASSERT(board != nullptr);
 	
 	// for custumized board size
-	if (m_customizedBoardSize != -1) {
-		board->setSize(m_customizedBoardSize);
+	if (m_boardWidth != -1) {
+		board->setWidth(m_boardWidth);
+		board->setHeight(m_boardHeight);
 	}
 
 	ChessGame* game = new ChessGame(board, new PgnGame());
 
-	connect(game, SIGNAL(started(ChessGame*)),
-		this, SLOT(onGameStarted(ChessGame*)));
-	connect(game, SIGNAL(finished(ChessGame*)),
-		this, SLOT(onGameFinished(ChessGame*)));
-
 	game->setTimeControl(white.timeControl(), Chess::Side::White);
 	game->setTimeControl(black.timeControl(), Chess::Side::Black);
 
@@ -414,15 +437,13 @@ void Tournament::startGame(TournamentPair* pair)
 	game->pgn()->setSite(m_site);
 	game->pgn()->setRound(m_round);
 
-	if (m_finishedGameCount > 0)
-		game->setStartDelay(m_startDelay);
 	game->setAdjudicator(m_adjudicator);
+	game->setSwapOpening(m_swapOpening);
 
 	GameData* data = new GameData;
 	data->number = ++m_nextGameNumber;
 	data->whiteIndex = m_pair->firstPlayer();
 	data->blackIndex = m_pair->secondPlayer();
-	m_gameData[game] = data;
 
 	// Some tournament types may require more games than expected
 	if (m_nextGameNumber > m_finalGameCount)
@@ -433,8 +454,25 @@ void Tournament::startGame(TournamentPair* pair)
 	if (m_swapSides)
 		m_pair->swapPlayers();
 
-	auto whiteBuilder = white.builder();
-	auto blackBuilder = black.builder();
+	PreparedGame prepared = { game, data };
+	return prepared;
+}
+
+void Tournament::launchGame(const PreparedGame& prepared)
+{
+	ChessGame* game = prepared.game;
+	m_gameData[game] = prepared.data;
+
+	connect(game, SIGNAL(started(ChessGame*)),
+		this, SLOT(onGameStarted(ChessGame*)));
+	connect(game, SIGNAL(finished(ChessGame*)),
+		this, SLOT(onGameFinished(ChessGame*)));
+
+	if (m_finishedGameCount > 0)
+		game->setStartDelay(m_startDelay);
+
+	auto whiteBuilder = m_players[prepared.data->whiteIndex].builder();
+	auto blackBuilder = m_players[prepared.data->blackIndex].builder();
 	onGameAboutToStart(game, whiteBuilder, blackBuilder);
 	connect(game, SIGNAL(startFailed(ChessGame*)),
 		this, SLOT(onGameStartFailed(ChessGame*)));
@@ -460,14 +498,22 @@ int Tournament::playerIndex(ChessGame* game, Chess::Side side) const
 	return side == Chess::Side::White ? gd->whiteIndex : gd->blackIndex;
 }
 
-void Tournament::startNextGame()
+void Tournament::discardPreparedGames()
 {
-	if (m_stopping)
-		return;
+	for (const PreparedGame& prepared : qAsConst(m_preparedGames))
+	{
+		delete prepared.game->pgn();
+		delete prepared.game;
+		delete prepared.data;
+	}
+	m_preparedGames.clear();
+}
 
+TournamentPair* Tournament::takeNextPair()
+{
 	TournamentPair* pair(nextPair(m_nextGameNumber));
 	if (!pair || !pair->isValid())
-		return;
+		return nullptr;
 
 	if ((!pair->hasSamePlayers(m_pair) && m_players.size() > 2
 	     && m_openingPolicy != OpeningPolicy::RoundPolicy)
@@ -480,7 +526,43 @@ void Tournament::startNextGame()
 		m_oldRound = m_round;
 	}
 
-	startGame(pair);
+	return pair;
+}
+
+void Tournament::startNextGame()
+{
+	if (m_stopping)
+		return;
+
+	if (!m_preparedGames.isEmpty())
+		launchGame(m_preparedGames.takeFirst());
+	else
+	{
+		TournamentPair* pair = takeNextPair();
+		if (pair == nullptr)
+			return;
+		startGame(pair);
+	}
+
+	// Build the next games after this one has been handed over
+	if (m_lookahead > 0)
+		QMetaObject::invokeMethod(this, "prepareGames",
+					  Qt::QueuedConnection);
+}
+
+void Tournament::prepareGames()
+{
+	// Nothing more is started once the last game has finished
+	if (m_stopping || m_finished || m_lastGame != nullptr)
+		return;
+
+	while (m_preparedGames.size() < m_lookahead)
+	{
+		TournamentPair* pair = takeNextPair();
+		if (pair == nullptr)
+			break;
+		m_preparedGames << prepareGame(pair);
+	}
 }
 
 inline bool faulty(const Chess::Result::Type& type)
@@ -614,6 +696,9 @@ void Tournament::onGameFinished(ChessGame* game)
 
 	int iWhite = data->whiteIndex;
 	int iBlack = data->blackIndex;
+	// The players can exchange colors in a swap opening
+	if (game->playersSwapped())
+		std::swap(iWhite, iBlack);
 	const auto whiteName = pgn->playerName(Chess::Side::White);
 	if (!whiteName.isEmpty())
 		m_players[iWhite].setName(whiteName);
@@ -718,6 +803,7 @@ void Tournament::start()
 		setOpeningRepetitions(INT_MAX);
 
 	m_gameData.clear();
+	discardPreparedGames();
 	m_pgnGames.clear();
 	m_startFen.clear();
 	m_openingMoves.clear();
@@ -738,6 +824,7 @@ void Tournament::stop()
 
 	disconnect(m_gameManager, SIGNAL(ready()),
 		   this, SLOT(startNextGame()));
+	discardPreparedGames();
 
 	if (m_gameData.isEmpty())
 	{
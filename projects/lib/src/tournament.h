@@ -29,11 +29,11 @@
 #include "timecontrol.h"
 #include "pgngame.h"
 #include "gameadjudicator.h"
+#include "chessgame.h"
 #include "tournamentplayer.h"
 #include "tournamentpair.h"
 class GameManager;
 class PlayerBuilder;
-class ChessGame;
 class OpeningBook;
 class OpeningSuite;
 class Sprt;
@@ -151,6 +151,24 @@ class LIB_EXPORT Tournament : public QObject
 		void setRoundMultiplier(int factor);
 		/*! Sets the starting delay for each game to \a delay msec. */
 		void setStartDelay(int delay);
+		/*!
+		 * Returns the number of games that are prepared ahead of
+		 * time.
+		 *
+		 * \sa setLookahead()
+		 */
+		int lookahead() const;
+		/*!
+		 * Sets the number of games that are prepared ahead of time
+		 * to \a games.
+		 *
+		 * The games, their PGN data and their openings are built
+		 * while the previous games are running, so that a prepared
+		 * game can be handed to the game manager as soon as a game
+		 * slot is free. The default is 0: every game is built when
+		 * it's started.
+		 */
+		void setLookahead(int games);
 		/*!
 		 * Sets the recovery mode to \a recover.
 		 *
@@ -238,6 +256,12 @@ class LIB_EXPORT Tournament : public QObject
 		 * swap sides for the following game.
 		 */
 		void setSwapSides(bool enabled);
+		/*!
+		 * Sets the swap opening rule of the games to \a rule.
+		 *
+		 * The default is ChessGame::NoSwapOpening.
+		 */
+		void setSwapOpening(ChessGame::SwapOpening rule);
 		/*!
 		 * Sets opening book ownership to \a enabled.
 		 *
@@ -251,10 +275,10 @@ class LIB_EXPORT Tournament : public QObject
 		 */
 		void setSeedCount(int seedCount);
 		/*!
-		 * Set costumized board size.
+		 * Set costumized board size of \a width x \a height squares.
 		 * Note that this would not work for chess boards. It is only for gomoku.
 		 */
-		void setBoardSize(int sz);
+		void setBoardSize(int width, int height);
 		/*!
 		 * Adds player \a builder to the tournament.
 		 *
@@ -422,6 +446,7 @@ class LIB_EXPORT Tournament : public QObject
 
 	private slots:
 		void startNextGame();
+		void prepareGames();
 		bool writePgn(PgnGame* pgn, int gameNumber);
 		bool writeEpd(ChessGame* game);
 		void onGameStarted(ChessGame* game);
@@ -436,6 +461,11 @@ class LIB_EXPORT Tournament : public QObject
 			int whiteIndex;
 			int blackIndex;
 		};
+		struct PreparedGame
+		{
+			ChessGame* game;
+			GameData* data;
+		};
 		struct RankingData
 		{
 			QString name;
@@ -446,6 +476,11 @@ class LIB_EXPORT Tournament : public QObject
 			qreal eloDiff;
 		};
 
+		TournamentPair* takeNextPair();
+		PreparedGame prepareGame(TournamentPair* pair);
+		void launchGame(const PreparedGame& prepared);
+		void discardPreparedGames();
+
 		GameManager* m_gameManager;
 		ChessGame* m_lastGame;
 		QString m_error;
@@ -461,11 +496,13 @@ class LIB_EXPORT Tournament : public QObject
 		int m_gamesPerEncounter;
 		int m_roundMultiplier;
 		int m_startDelay;
+		int m_lookahead;
 		int m_openingDepth;
 		int m_seedCount;
 		bool m_stopping;
 		int m_openingRepetitions;
 		OpeningPolicy m_openingPolicy;
+		ChessGame::SwapOpening m_swapOpening;
 		bool m_recover;
 		bool m_pgnCleanup;
 		bool m_pgnWriteUnfinishedGames;
@@ -487,8 +524,10 @@ class LIB_EXPORT Tournament : public QObject
 		QList<TournamentPlayer> m_players;
 		QMap<int, PgnGame> m_pgnGames;
 		QMap<ChessGame*, GameData*> m_gameData;
+		QList<PreparedGame> m_preparedGames;
 		QVector<Chess::Move> m_openingMoves;
-		int m_customizedBoardSize;
+		int m_boardWidth;
+		int m_boardHeight;
 };
 
 #endif // TOURNAMENT_H
@@ -0,0 +1,72 @@
+/*
+    This file is part of Cute Chess.
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "trace.h"
+#include <QAtomicInt>
+#include <QRegularExpression>
+#include <QStringList>
+
+Q_LOGGING_CATEGORY(lcBoard, "cutechess.board", QtWarningMsg)
+Q_LOGGING_CATEGORY(lcGomokuBoard, "cutechess.board.gomoku", QtWarningMsg)
+Q_LOGGING_CATEGORY(lcGomocup, "cutechess.engine.gomocup", QtWarningMsg)
+
+namespace {
+
+QAtomicInt s_lastId(0);
+
+} // anonymous namespace
+
+namespace Trace {
+
+bool setFilter(const QString& spec)
+{
+	static const QRegularExpression categoryRx("^[A-Za-z0-9_.*]+$");
+	QStringList rules;
+
+	const auto items = spec.split(',', QString::SkipEmptyParts);
+	for (const QString& item : items)
+	{
+		const QString category = item.section('=', 0, 0).trimmed();
+		const QString levelStr = item.section('=', 1).trimmed();
+		if (!categoryRx.match(category).hasMatch())
+			return false;
+
+		Level level = Info;
+		if (levelStr == "off")
+			level = Off;
+		else if (levelStr == "verbose")
+			level = Verbose;
+		else if (!levelStr.isEmpty() && levelStr != "info")
+			return false;
+
+		const QString name = "cutechess." + category;
+		rules << QString("%1.info=%2").arg(name, level >= Info ? "true" : "false")
+		      << QString("%1.debug=%2").arg(name, level >= Verbose ? "true" : "false");
+	}
+	if (rules.isEmpty())
+		return false;
+
+	QLoggingCategory::setFilterRules(rules.join('\n'));
+	return true;
+}
+
+int nextId()
+{
+	return s_lastId.fetchAndAddRelaxed(1) + 1;
+}
+
+} // namespace Trace
@@ -0,0 +1,96 @@
+/*
+    This file is part of Cute Chess.
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QLoggingCategory>
+#include <QString>
+
+/*!
+ * \file trace.h
+ * \brief Gated diagnostic output for the library's hot paths
+ *
+ * Trace messages are written to a QLoggingCategory at one of two
+ * levels: ccTrace() for one line per event (info level) and
+ * ccTraceVerbose() for bulky dumps such as board diagrams (debug
+ * level).
+ *
+ * All trace categories are disabled by default. They can be turned
+ * on at runtime with Trace::setFilter() or the \c QT_LOGGING_RULES
+ * environment variable. Because the macros expand to qCInfo() and
+ * qCDebug(), the stream expression is not evaluated at all while
+ * the category is disabled.
+ *
+ * Defining \c CUTECHESS_NO_TRACE at compile time removes the trace
+ * statements completely.
+ */
+
+/*! Generic board events ("cutechess.board"). */
+extern LIB_EXPORT const QLoggingCategory& lcBoard();
+/*! Gomoku board events ("cutechess.board.gomoku"). */
+extern LIB_EXPORT const QLoggingCategory& lcGomokuBoard();
+/*! Gomocup protocol events ("cutechess.engine.gomocup"). */
+extern LIB_EXPORT const QLoggingCategory& lcGomocup();
+
+#ifndef CUTECHESS_NO_TRACE
+#define ccTrace(category) qCInfo(category)
+#define ccTraceVerbose(category) qCDebug(category)
+#define ccTraceEnabled(category) (category().isInfoEnabled())
+#define ccTraceVerboseEnabled(category) (category().isDebugEnabled())
+#else
+#define ccTrace(category) QT_NO_QDEBUG_MACRO()
+#define ccTraceVerbose(category) QT_NO_QDEBUG_MACRO()
+#define ccTraceEnabled(category) false
+#define ccTraceVerboseEnabled(category) false
+#endif
+
+namespace Trace {
+
+/*! Trace levels, from least to most output. */
+enum Level
+{
+	Off,	//!< No trace output
+	Info,	//!< One line per event
+	Verbose	//!< Full dumps, eg. board diagrams
+};
+
+/*!
+ * Enables trace output according to \a spec.
+ *
+ * \a spec is a comma-separated list of \c category[=level] items,
+ * where \c category is a trace category name without the
+ * "cutechess." prefix (wildcards are allowed, eg. "board.*") and
+ * \c level is "off", "info" or "verbose". The default level is
+ * "info".
+ *
+ * Returns false if \a spec is invalid; in that case the filter
+ * rules are not changed.
+ */
+LIB_EXPORT bool setFilter(const QString& spec);
+
+/*!
+ * Returns a new unique trace id.
+ *
+ * Objects that write trace messages use the id in their message
+ * prefix so that the output of concurrent games can be told apart.
+ */
+LIB_EXPORT int nextId();
+
+} // namespace Trace
+
+#endif // TRACE_H
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_concurrencycontroller
+SOURCES += tst_concurrencycontroller.cpp
@@ -0,0 +1,141 @@
+#include <QtTest/QtTest>
+#include <concurrencycontroller.h>
+#include <gamemanager.h>
+
+class MockController: public ConcurrencyController
+{
+	public:
+		MockController(GameManager* manager)
+			: ConcurrencyController(manager),
+			  m_load(0.9)
+		{
+		}
+
+		void setLoad(double load)
+		{
+			m_load = load;
+		}
+
+	protected:
+		virtual double load() const
+		{
+			return m_load;
+		}
+
+	private:
+		double m_load;
+};
+
+class tst_ConcurrencyController: public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void range();
+		void decision_data() const;
+		void decision();
+		void window();
+};
+
+void tst_ConcurrencyController::range()
+{
+	GameManager manager;
+	manager.setConcurrency(20);
+
+	MockController controller(&manager);
+	controller.setRange(2, 16);
+	QCOMPARE(controller.minimum(), 2);
+	QCOMPARE(controller.maximum(), 16);
+	QCOMPARE(manager.concurrency(), 16);
+
+	manager.setConcurrency(1);
+	controller.setRange(4, 8);
+	QCOMPARE(manager.concurrency(), 4);
+}
+
+void tst_ConcurrencyController::decision_data() const
+{
+	QTest::addColumn<int>("concurrency");
+	QTest::addColumn<double>("load");
+	QTest::addColumn<bool>("timeLoss");
+	QTest::addColumn<int>("overtimeMoves");
+	QTest::addColumn<int>("expected");
+
+	QTest::newRow("time loss") << 8 << 0.5 << true << 0 << 6;
+	QTest::newRow("time loss at minimum") << 2 << 0.5 << true << 0 << 2;
+	QTest::newRow("overtime moves") << 8 << 0.5 << false << 50 << 6;
+	QTest::newRow("few overtime moves") << 8 << 0.5 << false << 30 << 9;
+	QTest::newRow("high load") << 8 << 1.5 << false << 0 << 7;
+	QTest::newRow("busy") << 8 << 0.9 << false << 0 << 8;
+	QTest::newRow("idle") << 8 << 0.5 << false << 0 << 9;
+	QTest::newRow("idle at maximum") << 12 << 0.5 << false << 0 << 12;
+	QTest::newRow("unknown load") << 8 << -1.0 << false << 0 << 8;
+	QTest::newRow("unknown load, time loss")
+		<< 8 << -1.0 << true << 0 << 6;
+}
+
+void tst_ConcurrencyController::decision()
+{
+	QFETCH(int, concurrency);
+	QFETCH(double, load);
+	QFETCH(bool, timeLoss);
+	QFETCH(int, overtimeMoves);
+	QFETCH(int, expected);
+
+	GameManager manager;
+	manager.setConcurrency(concurrency);
+
+	MockController controller(&manager);
+	controller.setRange(2, 12);
+	controller.setInterval(4);
+	controller.setLoad(load);
+	QSignalSpy spy(&controller, SIGNAL(decisionMade(int, int, QString)));
+
+	// 4 games of 100 moves
+	for (int i = 0; i < 3; i++)
+		controller.addGame(false, 100, 0);
+	QCOMPARE(spy.count(), 0);
+	controller.addGame(timeLoss, 100, overtimeMoves);
+
+	QCOMPARE(spy.count(), 1);
+	const QList<QVariant> args = spy.takeFirst();
+	QCOMPARE(args.at(0).toInt(), concurrency);
+	QCOMPARE(args.at(1).toInt(), expected);
+	QVERIFY(!args.at(2).toString().isEmpty());
+	QCOMPARE(manager.concurrency(), expected);
+}
+
+void tst_ConcurrencyController::window()
+{
+	GameManager manager;
+	manager.setConcurrency(3);
+
+	MockController controller(&manager);
+	controller.setRange(1, 8);
+	controller.setLoad(0.5);
+	QCOMPARE(controller.interval(), 0);
+	QSignalSpy spy(&controller, SIGNAL(decisionMade(int, int, QString)));
+
+	// One decision per generation of games
+	for (int i = 0; i < 3; i++)
+		controller.addGame(false, 50, 0);
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(manager.concurrency(), 4);
+
+	for (int i = 0; i < 3; i++)
+		controller.addGame(false, 50, 0);
+	QCOMPARE(spy.count(), 1);
+	controller.addGame(false, 50, 0);
+	QCOMPARE(spy.count(), 2);
+	QCOMPARE(manager.concurrency(), 5);
+
+	// The statistics start over after a decision
+	controller.addGame(true, 50, 0);
+	for (int i = 0; i < 4; i++)
+		controller.addGame(false, 50, 0);
+	QCOMPARE(spy.count(), 3);
+	QCOMPARE(manager.concurrency(), 4);
+}
+
+QTEST_MAIN(tst_ConcurrencyController)
+#include "tst_concurrencycontroller.moc"
@@ -0,0 +1,127 @@
+#include <QtTest/QtTest>
+#include <cpuaffinity.h>
+
+typedef QList<int> CpuList;
+
+static CpuList cpuRange(int first, int last)
+{
+	CpuList cpus;
+	for (int cpu = first; cpu <= last; cpu++)
+		cpus << cpu;
+	return cpus;
+}
+
+class tst_CpuAffinity: public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void parse_data() const;
+		void parse();
+		void invalid_data() const;
+		void invalid();
+		void availableCpus();
+		void cpuListString();
+};
+
+void tst_CpuAffinity::parse_data() const
+{
+	QTest::addColumn<QString>("policy");
+	QTest::addColumn<CpuList>("available");
+	QTest::addColumn<int>("slotCount");
+	QTest::addColumn<QString>("expected");
+
+	QTest::newRow("compact")
+		<< "compact" << cpuRange(0, 7) << 4
+		<< "0-1 2-3 4-5 6-7";
+	QTest::newRow("spread")
+		<< "spread" << cpuRange(0, 7) << 4
+		<< "0-1 4-5 2-3 6-7";
+	QTest::newRow("spread odd")
+		<< "spread" << cpuRange(0, 5) << 3
+		<< "0-1 4-5 2-3";
+	QTest::newRow("single cpu")
+		<< "compact" << cpuRange(0, 0) << 1
+		<< "0";
+	QTest::newRow("compact cpuset")
+		<< "compact" << cpuRange(8, 13) << 3
+		<< "8-9 10-11 12-13";
+	QTest::newRow("spread cpuset")
+		<< "spread" << (CpuList() << 2 << 3 << 6 << 7) << 2
+		<< "2-3 6-7";
+	QTest::newRow("list")
+		<< "list:2-4,8" << cpuRange(0, 15) << 2
+		<< "2-3 4,8";
+	QTest::newRow("list single")
+		<< "list:5" << cpuRange(0, 15) << 1
+		<< "5";
+}
+
+void tst_CpuAffinity::parse()
+{
+	QFETCH(QString, policy);
+	QFETCH(CpuList, available);
+	QFETCH(int, slotCount);
+	QFETCH(QString, expected);
+
+	CpuAffinity affinity;
+	QVERIFY(!affinity.isEnabled());
+	QVERIFY(affinity.parse(policy, available));
+	QVERIFY(affinity.isEnabled());
+	QCOMPARE(affinity.toString(), policy);
+	QCOMPARE(affinity.slotCount(), slotCount);
+
+	QStringList actual;
+	for (int i = 0; i < slotCount; i++)
+		actual << CpuAffinity::cpuListString(affinity.cpus(i));
+	QCOMPARE(actual.join(' '), expected);
+
+	// More games than slots share them
+	QCOMPARE(affinity.cpus(slotCount), affinity.cpus(0));
+}
+
+void tst_CpuAffinity::invalid_data() const
+{
+	QTest::addColumn<QString>("policy");
+
+	QTest::newRow("empty") << "";
+	QTest::newRow("unknown") << "scatter";
+	QTest::newRow("empty list") << "list:";
+	QTest::newRow("too large") << "list:0-8";
+	QTest::newRow("outside cpuset") << "list:4";
+	QTest::newRow("reversed") << "list:3-1";
+	QTest::newRow("garbage") << "list:1,x";
+}
+
+void tst_CpuAffinity::invalid()
+{
+	QFETCH(QString, policy);
+
+	// The process may only run on CPUs 0-3 and 5-7
+	const CpuList available = cpuRange(0, 3) + cpuRange(5, 7);
+
+	CpuAffinity affinity;
+	QVERIFY(affinity.parse("compact", available));
+	QVERIFY(!affinity.parse(policy, available));
+	QCOMPARE(affinity.policy(), CpuAffinity::Compact);
+}
+
+void tst_CpuAffinity::availableCpus()
+{
+	const CpuList cpus = CpuAffinity::availableCpus();
+	QVERIFY(!cpus.isEmpty());
+	for (int i = 1; i < cpus.size(); i++)
+		QVERIFY(cpus.at(i) > cpus.at(i - 1));
+}
+
+void tst_CpuAffinity::cpuListString()
+{
+	QCOMPARE(CpuAffinity::cpuListString(CpuList()), QString());
+	QCOMPARE(CpuAffinity::cpuListString(CpuList() << 0 << 1 << 2 << 5),
+		 QString("0-2,5"));
+	QCOMPARE(CpuAffinity::cpuListString(CpuList() << 7 << 3),
+		 QString("7,3"));
+}
+
+QTEST_MAIN(tst_CpuAffinity)
+#include "tst_cpuaffinity.moc"
@@ -0,0 +1,86 @@
+#include <QtTest/QtTest>
+#include <gamemanager.h>
+#include <humanbuilder.h>
+#include <chessgame.h>
+#include <pgngame.h>
+#include <timecontrol.h>
+#include <board/boardfactory.h>
+
+typedef QList<int> CpuList;
+
+class tst_GameManager: public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void affinityAfterPairingChange();
+
+	private:
+		ChessGame* startGame(GameManager* manager,
+				     const PlayerBuilder* white,
+				     const PlayerBuilder* black);
+		void stopGame(GameManager* manager, ChessGame* game);
+};
+
+ChessGame* tst_GameManager::startGame(GameManager* manager,
+				      const PlayerBuilder* white,
+				      const PlayerBuilder* black)
+{
+	TimeControl tc;
+	tc.setInfinity(true);
+
+	auto game = new ChessGame(Chess::BoardFactory::create("gomoku"),
+				  new PgnGame);
+	game->setTimeControl(tc);
+	connect(game, SIGNAL(finished(ChessGame*)),
+		game, SLOT(deleteLater()));
+
+	QSignalSpy spy(manager, SIGNAL(gameStarted(ChessGame*)));
+	manager->newGame(game, white, black,
+			 GameManager::StartImmediately,
+			 GameManager::ReusePlayers);
+	if (!spy.wait())
+		return nullptr;
+	return game;
+}
+
+void tst_GameManager::stopGame(GameManager* manager, ChessGame* game)
+{
+	QSignalSpy spy(manager, SIGNAL(gameDestroyed(ChessGame*)));
+	QMetaObject::invokeMethod(game, "stop", Qt::QueuedConnection);
+	QVERIFY(spy.wait());
+}
+
+void tst_GameManager::affinityAfterPairingChange()
+{
+	HumanBuilder players[6];
+	GameManager manager;
+
+	CpuAffinity affinity;
+	QVERIFY(affinity.parse("compact", CpuList() << 0 << 1 << 2 << 3));
+	manager.setCpuAffinity(affinity);
+
+	ChessGame* game1 = startGame(&manager, &players[0], &players[1]);
+	ChessGame* game2 = startGame(&manager, &players[2], &players[3]);
+	QVERIFY(game1 != nullptr);
+	QVERIFY(game2 != nullptr);
+	QCOMPARE(manager.gameCpus(game1), CpuList() << 0 << 1);
+	QCOMPARE(manager.gameCpus(game2), CpuList() << 2 << 3);
+
+	// A new pairing gets the CPUs of the finished game even if
+	// the old game slot hasn't shut down yet
+	stopGame(&manager, game2);
+	ChessGame* game3 = startGame(&manager, &players[4], &players[5]);
+	QVERIFY(game3 != nullptr);
+	QCOMPARE(manager.gameCpus(game3), CpuList() << 2 << 3);
+	QCOMPARE(manager.gameCpus(game1), CpuList() << 0 << 1);
+
+	stopGame(&manager, game1);
+	stopGame(&manager, game3);
+	QSignalSpy finished(&manager, SIGNAL(finished()));
+	manager.finish();
+	QVERIFY(finished.count() > 0 || finished.wait());
+}
+
+QTEST_MAIN(tst_GameManager)
+#include "tst_gamemanager.moc"
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_gomocupevalparser
+SOURCES += tst_gomocupevalparser.cpp
@@ -0,0 +1,107 @@
+#include <QtTest/QtTest>
+#include <gomocupevalparser.h>
+#include <moveevaluation.h>
+
+
+class tst_GomocupEvalParser: public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void parse_data() const;
+		void parse();
+		void keys();
+};
+
+
+void tst_GomocupEvalParser::parse_data() const
+{
+	QTest::addColumn<QByteArray>("message");
+	QTest::addColumn<bool>("found");
+	QTest::addColumn<int>("depth");
+	QTest::addColumn<int>("selDepth");
+	QTest::addColumn<int>("score");
+	QTest::addColumn<quint64>("nodes");
+	QTest::addColumn<quint64>("nps");
+	QTest::addColumn<int>("time");
+	QTest::addColumn<QString>("pv");
+
+	QTest::newRow("short keys")
+		<< QByteArray("depth 12-20 ev 345 n 1.2M nps 850k tm 1500 pv h8 i9 j10")
+		<< true << 12 << 20 << 345
+		<< Q_UINT64_C(1200000) << Q_UINT64_C(850000) << 1500
+		<< "h8 i9 j10";
+	QTest::newRow("bars")
+		<< QByteArray("Depth 10 | Eval -M4 | Time 1.5s | Nodes 12345 | PV 7,7 8,8 | Hash 3")
+		<< true << 10 << 0 << -(MoveEvaluation::MATE_SCORE - 4)
+		<< Q_UINT64_C(12345) << Q_UINT64_C(0) << 1500
+		<< "7,7 8,8";
+	QTest::newRow("upper case")
+		<< QByteArray("DEPTH 11/18 EV +120 N 1234567 NPS 400000")
+		<< true << 11 << 18 << 120
+		<< Q_UINT64_C(1234567) << Q_UINT64_C(400000) << 0
+		<< "";
+	QTest::newRow("separators")
+		<< QByteArray("d: 5, val=-33")
+		<< true << 5 << 0 << -33
+		<< Q_UINT64_C(0) << Q_UINT64_C(0) << 0
+		<< "";
+	QTest::newRow("no keys")
+		<< QByteArray("hello world")
+		<< false << 0 << 0 << 0
+		<< Q_UINT64_C(0) << Q_UINT64_C(0) << 0
+		<< "";
+	QTest::newRow("key without value")
+		<< QByteArray("depth")
+		<< false << 0 << 0 << 0
+		<< Q_UINT64_C(0) << Q_UINT64_C(0) << 0
+		<< "";
+}
+
+void tst_GomocupEvalParser::parse()
+{
+	QFETCH(QByteArray, message);
+	QFETCH(bool, found);
+	QFETCH(int, depth);
+	QFETCH(int, selDepth);
+	QFETCH(int, score);
+	QFETCH(quint64, nodes);
+	QFETCH(quint64, nps);
+	QFETCH(int, time);
+	QFETCH(QString, pv);
+
+	GomocupEvalParser parser;
+	MoveEvaluation eval;
+	QCOMPARE(parser.parse(message.constData(), message.size(), &eval), found);
+	QCOMPARE(eval.depth(), depth);
+	QCOMPARE(eval.selectiveDepth(), selDepth);
+	if (found)
+		QCOMPARE(eval.score(), score);
+	QCOMPARE(eval.nodeCount(), nodes);
+	QCOMPARE(eval.nps(), nps);
+	QCOMPARE(eval.time(), time);
+	QCOMPARE(eval.pv(), pv);
+}
+
+void tst_GomocupEvalParser::keys()
+{
+	GomocupEvalParser parser;
+	QVERIFY(parser.isEnabled());
+
+	QVERIFY(!parser.setKeys("depth=dep;bogus=x"));
+	QVERIFY(!parser.setKeys("score=1x"));
+	QVERIFY(parser.isEnabled());
+
+	QVERIFY(parser.setKeys("depth=dep;score=cp"));
+	const QByteArray message("dep 7 cp 12 depth 9");
+	MoveEvaluation eval;
+	QVERIFY(parser.parse(message.constData(), message.size(), &eval));
+	QCOMPARE(eval.depth(), 7);
+	QCOMPARE(eval.score(), 12);
+
+	QVERIFY(parser.setKeys(QString()));
+	QVERIFY(!parser.isEnabled());
+}
+
+QTEST_MAIN(tst_GomocupEvalParser)
+#include "tst_gomocupevalparser.moc"
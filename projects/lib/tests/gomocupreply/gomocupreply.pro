@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_gomocupreply
+SOURCES += tst_gomocupreply.cpp
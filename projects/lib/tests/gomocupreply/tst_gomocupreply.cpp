@@ -0,0 +1,114 @@
+#include <QtTest/QtTest>
+#include <gomocupreply.h>
+
+
+class tst_GomocupReply: public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void parse_data() const;
+		void parse();
+};
+
+Q_DECLARE_METATYPE(GomocupReply::Type)
+
+void tst_GomocupReply::parse_data() const
+{
+	QTest::addColumn<QByteArray>("line");
+	QTest::addColumn<GomocupReply::Type>("type");
+	QTest::addColumn<int>("count");
+	QTest::addColumn<int>("x");
+	QTest::addColumn<int>("y");
+	QTest::addColumn<QString>("text");
+
+	QTest::newRow("move")
+		<< QByteArray("7,12")
+		<< GomocupReply::Coordinates << 1 << 7 << 12
+		<< "7,12";
+	QTest::newRow("move with spaces")
+		<< QByteArray("  10 , 3 \r")
+		<< GomocupReply::Coordinates << 1 << 10 << 3
+		<< "10 , 3";
+	QTest::newRow("move with garbage")
+		<< QByteArray("7,12x")
+		<< GomocupReply::Other << 0 << -1 << -1
+		<< "7,12x";
+	QTest::newRow("move too long")
+		<< QByteArray("123456,1")
+		<< GomocupReply::Other << 0 << -1 << -1
+		<< "123456,1";
+	QTest::newRow("three moves")
+		<< QByteArray("7,7 8,8  9,10")
+		<< GomocupReply::Coordinates << 3 << 7 << 7
+		<< "7,7 8,8  9,10";
+	QTest::newRow("four moves")
+		<< QByteArray("7,7 8,8 9,9 10,10")
+		<< GomocupReply::Other << 0 << -1 << -1
+		<< "7,7 8,8 9,9 10,10";
+	QTest::newRow("empty")
+		<< QByteArray(" \t")
+		<< GomocupReply::Empty << 0 << -1 << -1
+		<< "";
+	QTest::newRow("ok")
+		<< QByteArray("OK")
+		<< GomocupReply::Ok << 0 << -1 << -1
+		<< "";
+	QTest::newRow("not ok")
+		<< QByteArray("OKAY")
+		<< GomocupReply::Other << 0 << -1 << -1
+		<< "OKAY";
+	QTest::newRow("message")
+		<< QByteArray("MESSAGE depth 12 eval +35 ")
+		<< GomocupReply::Message << 0 << -1 << -1
+		<< "depth 12 eval +35";
+	QTest::newRow("debug")
+		<< QByteArray("DEBUG")
+		<< GomocupReply::Debug << 0 << -1 << -1
+		<< "";
+	QTest::newRow("unknown")
+		<< QByteArray("UNKNOWN command RESTART")
+		<< GomocupReply::Unknown << 0 << -1 << -1
+		<< "command RESTART";
+	QTest::newRow("error")
+		<< QByteArray("ERROR unsupported size")
+		<< GomocupReply::Error << 0 << -1 << -1
+		<< "unsupported size";
+	QTest::newRow("suggest")
+		<< QByteArray("SUGGEST 5,6")
+		<< GomocupReply::Suggest << 1 << 5 << 6
+		<< "5,6";
+	QTest::newRow("swap")
+		<< QByteArray("SWAP")
+		<< GomocupReply::Swap << 0 << -1 << -1
+		<< "";
+	QTest::newRow("about")
+		<< QByteArray("name=\"pbrain\", version=\"1.0\"")
+		<< GomocupReply::About << 0 << -1 << -1
+		<< "name=\"pbrain\", version=\"1.0\"";
+	QTest::newRow("utf-8")
+		<< QByteArray("MESSAGE \xc3\xa9l\xc3\xa8ve")
+		<< GomocupReply::Message << 0 << -1 << -1
+		<< QString::fromUtf8("\xc3\xa9l\xc3\xa8ve");
+}
+
+void tst_GomocupReply::parse()
+{
+	QFETCH(QByteArray, line);
+	QFETCH(GomocupReply::Type, type);
+	QFETCH(int, count);
+	QFETCH(int, x);
+	QFETCH(int, y);
+	QFETCH(QString, text);
+
+	const GomocupReply reply(line);
+	QCOMPARE(reply.type(), type);
+	QCOMPARE(reply.count(), count);
+	QCOMPARE(reply.x(), x);
+	QCOMPARE(reply.y(), y);
+	QCOMPARE(reply.text(), text);
+	QCOMPARE(reply.x(count), -1);
+}
+
+QTEST_MAIN(tst_GomocupReply)
+#include "tst_gomocupreply.moc"
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_gomokuboard
+SOURCES += tst_gomokuboard.cpp
@@ -0,0 +1,544 @@
+#include <QtTest/QtTest>
+#include <board/board.h>
+#include <board/boardfactory.h>
+#include <board/gomokuboard.h>
+#include <board/renjuboard.h>
+
+
+class tst_GomokuBoard: public QObject
+{
+	Q_OBJECT
+
+	public:
+		tst_GomokuBoard();
+
+	private slots:
+		void results_data() const;
+		void results();
+
+		void fenStrings_data() const;
+		void fenStrings();
+		void legalMoves();
+		void largeBoards();
+		void candidateMoves_data() const;
+		void candidateMoves();
+
+		void forbiddenMoves_data() const;
+		void forbiddenMoves();
+
+		void threats_data() const;
+		void threats();
+
+		void zobristKeys();
+		void positions();
+		void canonicalKeys_data() const;
+		void canonicalKeys();
+
+		void cleanupTestCase();
+
+	private:
+		void setVariant(const QString& variant);
+		void playMoves(const QString& moves);
+		Chess::Board* m_board;
+};
+
+
+tst_GomokuBoard::tst_GomokuBoard()
+	: m_board(0)
+{
+}
+
+void tst_GomokuBoard::cleanupTestCase()
+{
+	delete m_board;
+}
+
+void tst_GomokuBoard::setVariant(const QString& variant)
+{
+	if (m_board == 0 || m_board->variant() != variant)
+	{
+		delete m_board;
+		m_board = Chess::BoardFactory::create(variant);
+	}
+	QVERIFY(m_board != 0);
+	m_board->reset();
+}
+
+void tst_GomokuBoard::playMoves(const QString& moves)
+{
+	const QStringList list = moves.split(' ', QString::SkipEmptyParts);
+	for (const QString& str : list)
+	{
+		Chess::Move move = m_board->moveFromString(str);
+		QVERIFY2(!move.isNull(), qUtf8Printable(str));
+		QVERIFY2(m_board->isLegalMove(move), qUtf8Printable(str));
+		m_board->makeMove(move);
+	}
+}
+
+void tst_GomokuBoard::results_data() const
+{
+	QTest::addColumn<QString>("variant");
+	QTest::addColumn<QString>("moves");
+	QTest::addColumn<QString>("result");
+
+	QTest::newRow("gomoku empty")
+		<< "gomoku"
+		<< ""
+		<< "*";
+	QTest::newRow("gomoku four")
+		<< "gomoku"
+		<< "7,7 0,0 8,7 0,1 9,7 0,2 10,7"
+		<< "*";
+	QTest::newRow("gomoku horizontal five")
+		<< "gomoku"
+		<< "7,7 0,0 8,7 0,1 9,7 0,2 10,7 0,3 11,7"
+		<< "0-1";
+	QTest::newRow("gomoku five completed in the middle")
+		<< "gomoku"
+		<< "3,3 0,0 4,3 0,1 6,3 0,2 7,3 0,4 5,3"
+		<< "0-1";
+	QTest::newRow("gomoku vertical five")
+		<< "gomoku"
+		<< "7,7 14,0 7,8 14,1 7,9 14,2 7,10 14,3 0,0 14,4"
+		<< "1-0";
+	QTest::newRow("gomoku diagonal five")
+		<< "gomoku"
+		<< "0,0 14,0 1,1 14,1 2,2 14,2 3,3 14,4 4,4"
+		<< "0-1";
+	QTest::newRow("gomoku anti-diagonal five")
+		<< "gomoku"
+		<< "0,14 14,0 1,13 14,1 2,12 14,2 3,11 14,4 4,10"
+		<< "0-1";
+	QTest::newRow("gomoku broken five")
+		<< "gomoku"
+		<< "7,7 0,0 8,7 0,1 9,7 0,2 11,7 0,4 12,7"
+		<< "*";
+	QTest::newRow("gomoku overline")
+		<< "gomoku"
+		<< "3,7 0,0 4,7 0,2 5,7 0,4 7,7 0,6 8,7 0,8 6,7"
+		<< "0-1";
+	QTest::newRow("gomoku-standard five")
+		<< "gomoku-standard"
+		<< "7,7 0,0 8,7 0,1 9,7 0,2 10,7 0,3 11,7"
+		<< "0-1";
+	QTest::newRow("gomoku-standard overline")
+		<< "gomoku-standard"
+		<< "3,7 0,0 4,7 0,2 5,7 0,4 7,7 0,6 8,7 0,8 6,7"
+		<< "*";
+	QTest::newRow("caro open five")
+		<< "caro"
+		<< "7,7 0,0 8,7 0,1 9,7 0,2 10,7 0,3 11,7"
+		<< "0-1";
+	QTest::newRow("caro five blocked at one end")
+		<< "caro"
+		<< "7,7 6,7 8,7 0,0 9,7 0,2 10,7 0,4 11,7"
+		<< "0-1";
+	QTest::newRow("caro five blocked at both ends")
+		<< "caro"
+		<< "7,7 6,7 8,7 12,7 9,7 0,0 10,7 0,2 11,7"
+		<< "*";
+	QTest::newRow("caro five at the edge")
+		<< "caro"
+		<< "0,7 5,7 1,7 0,0 2,7 0,2 3,7 0,4 4,7"
+		<< "0-1";
+	QTest::newRow("renju black five")
+		<< "renju"
+		<< "3,7 0,0 4,7 0,2 5,7 0,4 6,7 0,6 7,7"
+		<< "0-1";
+	QTest::newRow("renju white overline")
+		<< "renju"
+		<< "7,7 0,0 9,7 1,0 7,9 2,0 9,9 4,0 11,11 5,0 13,13 3,0"
+		<< "1-0";
+}
+
+void tst_GomokuBoard::results()
+{
+	QFETCH(QString, variant);
+	QFETCH(QString, moves);
+	QFETCH(QString, result);
+
+	setVariant(variant);
+	playMoves(moves);
+	QCOMPARE(m_board->result().toShortString(), result);
+
+	// The cached result must be dropped when the last move is undone
+	if (!moves.isEmpty())
+	{
+		m_board->undoMove();
+		QCOMPARE(m_board->result().toShortString(), QString("*"));
+	}
+}
+
+void tst_GomokuBoard::fenStrings_data() const
+{
+	QTest::addColumn<QString>("moves");
+	QTest::addColumn<QString>("fen");
+
+	QTest::newRow("empty")
+		<< ""
+		<< "15/15/15/15/15/15/15/15/15/15/15/15/15/15/15 b ";
+	QTest::newRow("center")
+		<< "7,7"
+		<< "15/15/15/15/15/15/15/7p7/15/15/15/15/15/15/15 w ";
+	QTest::newRow("corners")
+		<< "0,0 14,14 14,0 0,14"
+		<< "P13P/15/15/15/15/15/15/15/15/15/15/15/15/15/p13p b ";
+}
+
+void tst_GomokuBoard::fenStrings()
+{
+	QFETCH(QString, moves);
+	QFETCH(QString, fen);
+
+	setVariant("gomoku");
+	playMoves(moves);
+	QCOMPARE(m_board->fenString(), fen);
+}
+
+void tst_GomokuBoard::legalMoves()
+{
+	setVariant("gomoku");
+	m_board->setSize(19);
+	QCOMPARE(m_board->legalMoves().size(), 19 * 19);
+
+	playMoves("18,18 0,0 9,9");
+	QVector<Chess::Move> moves = m_board->legalMoves();
+	QCOMPARE(moves.size(), 19 * 19 - 3);
+	QVERIFY(!moves.contains(m_board->moveFromString("18,18")));
+	QVERIFY(moves.contains(m_board->moveFromString("18,17")));
+
+	// Undoing a move makes its square legal again
+	m_board->undoMove();
+	QVERIFY(m_board->isLegalMove(m_board->moveFromString("9,9")));
+	QVERIFY(!m_board->isLegalMove(m_board->moveFromString("0,0")));
+	QCOMPARE(m_board->legalMoves().size(), 19 * 19 - 2);
+
+	m_board->setSize(15);
+}
+
+void tst_GomokuBoard::largeBoards()
+{
+	setVariant("gomoku");
+	QVERIFY(Chess::GomokuBoard::isValidSize(64, 64));
+	QVERIFY(!Chess::GomokuBoard::isValidSize(65, 64));
+
+	m_board->setWidth(64);
+	m_board->setHeight(40);
+	QCOMPARE(m_board->legalMoves().size(), 64 * 40);
+
+	// A five that crosses the boundary between two line words
+	playMoves("22,33 0,0 23,33 0,1 24,33 0,2 25,33 0,3");
+	QCOMPARE(m_board->result().toShortString(), QString("*"));
+	playMoves("26,33");
+	QCOMPARE(m_board->result().toShortString(), QString("0-1"));
+
+	// A diagonal five near the far corner
+	m_board->reset();
+	playMoves("59,35 0,0 60,36 0,1 61,37 0,2 62,38 0,3 63,39");
+	QCOMPARE(m_board->result().toShortString(), QString("0-1"));
+	QVERIFY(m_board->isLegalMove(m_board->moveFromString("63,0")));
+	QVERIFY(m_board->moveFromString("64,0").isNull());
+
+	m_board->setSize(15);
+}
+
+void tst_GomokuBoard::candidateMoves_data() const
+{
+	QTest::addColumn<QString>("moves");
+	QTest::addColumn<int>("distance");
+	QTest::addColumn<QString>("candidates");
+
+	QTest::newRow("empty board")
+		<< ""
+		<< 2
+		<< "7,7";
+	QTest::newRow("corner")
+		<< "0,0"
+		<< 1
+		<< "1,0 0,1 1,1";
+	QTest::newRow("two stones")
+		<< "0,0 3,0"
+		<< 1
+		<< "1,0 2,0 4,0 0,1 1,1 2,1 3,1 4,1";
+	QTest::newRow("distance 2")
+		<< "14,14"
+		<< 2
+		<< "12,12 13,12 14,12 12,13 13,13 14,13 12,14 13,14";
+}
+
+void tst_GomokuBoard::candidateMoves()
+{
+	QFETCH(QString, moves);
+	QFETCH(int, distance);
+	QFETCH(QString, candidates);
+
+	setVariant("gomoku");
+	playMoves(moves);
+
+	auto board = dynamic_cast<Chess::GomokuBoard*>(m_board);
+	QVERIFY(board != nullptr);
+
+	QStringList list;
+	const auto result = board->candidateMoves(distance);
+	for (const auto& move : result)
+		list << m_board->moveString(move, Chess::Board::LongAlgebraic);
+	QCOMPARE(list.join(' '), candidates);
+}
+
+void tst_GomokuBoard::forbiddenMoves_data() const
+{
+	QTest::addColumn<QString>("moves");
+	QTest::addColumn<QString>("square");
+	QTest::addColumn<bool>("forbidden");
+
+	QTest::newRow("double three")
+		<< "5,7 0,14 6,7 2,14 7,5 4,14 7,6 6,14"
+		<< "7,7"
+		<< true;
+	QTest::newRow("double four")
+		<< "3,7 0,14 4,7 2,14 5,7 4,14 7,3 6,14 7,4 8,14 7,5 10,14"
+		<< "7,7"
+		<< true;
+	QTest::newRow("double four in one line")
+		<< "2,7 0,14 4,7 2,14 5,7 4,14 8,7 6,14"
+		<< "6,7"
+		<< true;
+	QTest::newRow("overline")
+		<< "2,7 0,14 3,7 2,14 4,7 4,14 6,7 6,14 7,7 8,14"
+		<< "5,7"
+		<< true;
+	QTest::newRow("five and double four")
+		<< "3,7 0,14 4,7 2,14 5,7 4,14 6,7 6,14 7,3 8,14 7,4 10,14 7,5 12,14"
+		<< "7,7"
+		<< false;
+	QTest::newRow("blocked three")
+		<< "5,7 8,7 6,7 0,14 7,5 2,14 7,6 4,14"
+		<< "7,7"
+		<< false;
+	QTest::newRow("three with one straight four")
+		<< "5,7 9,7 6,7 0,14 7,5 2,14 7,6 4,14"
+		<< "7,7"
+		<< true;
+	QTest::newRow("three whose four is an overline")
+		<< "5,7 9,7 6,7 0,14 7,5 2,14 7,6 4,14 "
+		   "4,3 6,14 4,4 8,14 4,5 10,14 4,6 12,14 4,8 14,14"
+		<< "7,7"
+		<< false;
+}
+
+void tst_GomokuBoard::forbiddenMoves()
+{
+	QFETCH(QString, moves);
+	QFETCH(QString, square);
+	QFETCH(bool, forbidden);
+
+	setVariant("renju");
+	playMoves(moves);
+	QCOMPARE(m_board->sideToMove(), Chess::Side(Chess::Side::Black));
+
+	auto renju = dynamic_cast<Chess::RenjuBoard*>(m_board);
+	QVERIFY(renju != nullptr);
+	QCOMPARE(renju->isForbidden(Chess::Square(square.section(',', 0, 0).toInt(),
+						  square.section(',', 1).toInt())),
+		 forbidden);
+
+	Chess::Move move = m_board->moveFromString(square);
+	QCOMPARE(m_board->isLegalMove(move), !forbidden);
+	QCOMPARE(m_board->legalMoves().contains(move), !forbidden);
+
+	// The cached verdicts must follow moves and undos
+	playMoves("14,0 14,2");
+	QCOMPARE(m_board->isLegalMove(move), !forbidden);
+	m_board->undoMove();
+	m_board->undoMove();
+	QCOMPARE(m_board->isLegalMove(move), !forbidden);
+}
+
+void tst_GomokuBoard::threats_data() const
+{
+	QTest::addColumn<QString>("moves");
+	QTest::addColumn<int>("pattern");
+	QTest::addColumn<QString>("squares");
+
+	// Black stones are on rank 7, white stones on the first ranks
+	QTest::newRow("open four")
+		<< "3,7 0,0 4,7 1,0 5,7 3,0 6,7"
+		<< int(Chess::GomokuPatterns::OpenFour)
+		<< "2,7";
+	QTest::newRow("blocked four")
+		<< "3,7 2,7 4,7 1,0 5,7 3,0 6,7"
+		<< int(Chess::GomokuPatterns::Four)
+		<< "3,7";
+	QTest::newRow("split four")
+		<< "3,7 0,0 4,7 1,0 6,7 3,0 7,7"
+		<< int(Chess::GomokuPatterns::Four)
+		<< "3,7";
+	QTest::newRow("open three")
+		<< "5,7 0,0 6,7 1,0 7,7"
+		<< int(Chess::GomokuPatterns::OpenThree)
+		<< "3,7";
+	QTest::newRow("three at the edge")
+		<< "0,7 0,0 1,7 1,0 2,7"
+		<< int(Chess::GomokuPatterns::OpenThree)
+		<< "";
+	QTest::newRow("broken three")
+		<< "5,7 0,0 7,7 1,0 8,7"
+		<< int(Chess::GomokuPatterns::BrokenThree)
+		<< "4,7";
+	QTest::newRow("vertical open four")
+		<< "7,3 0,0 7,4 1,0 7,5 3,0 7,6"
+		<< int(Chess::GomokuPatterns::OpenFour)
+		<< "7,2";
+	QTest::newRow("anti-diagonal open four")
+		<< "3,9 0,0 4,8 1,0 5,7 3,0 6,6"
+		<< int(Chess::GomokuPatterns::OpenFour)
+		<< "2,10";
+}
+
+void tst_GomokuBoard::threats()
+{
+	QFETCH(QString, moves);
+	QFETCH(int, pattern);
+	QFETCH(QString, squares);
+
+	setVariant("gomoku");
+	auto board = dynamic_cast<Chess::GomokuBoard*>(m_board);
+	QVERIFY(board != 0);
+	playMoves(moves);
+
+	QStringList found;
+	const auto threats = board->threats(Chess::Side::Black);
+	for (const auto& threat : threats)
+	{
+		if (threat.type != pattern)
+			continue;
+		found << QString("%1,%2").arg(threat.startSq.file())
+					 .arg(threat.startSq.rank());
+	}
+	QCOMPARE(found.join(' '), squares);
+}
+
+void tst_GomokuBoard::zobristKeys()
+{
+	setVariant("gomoku");
+	QCOMPARE(m_board->key(), Q_UINT64_C(0));
+
+	playMoves("7,7 8,8 9,9");
+	quint64 key = m_board->key();
+	QVERIFY(key != 0);
+
+	m_board->undoMove();
+	QVERIFY(m_board->key() != key);
+	playMoves("9,9");
+	QCOMPARE(m_board->key(), key);
+
+	// Transposition: same stones, different move order
+	m_board->reset();
+	playMoves("9,9 8,8 7,7");
+	QCOMPARE(m_board->key(), key);
+
+	// Same squares, but with the colors swapped
+	m_board->reset();
+	playMoves("8,8 7,7 9,9");
+	QVERIFY(m_board->key() != key);
+}
+
+void tst_GomokuBoard::positions()
+{
+	setVariant("gomoku");
+	m_board->setSize(19);
+	playMoves("9,9 10,10 9,10 10,9 9,11 10,11 9,12");
+
+	auto board = dynamic_cast<Chess::GomokuBoard*>(m_board);
+	QVERIFY(board != nullptr);
+	const Chess::GomokuPosition pos = board->position();
+	const QString fen = m_board->fenString();
+	const quint64 key = m_board->key();
+	QCOMPARE(int(pos.ply), 7);
+
+	Chess::GomokuBoard restored;
+	restored.setPosition(pos);
+	QCOMPARE(restored.width(), 19);
+	QCOMPARE(restored.height(), 19);
+	QCOMPARE(restored.fenString(), fen);
+	QCOMPARE(restored.key(), key);
+	QCOMPARE(restored.plyCount(), 7);
+	QCOMPARE(restored.sideToMove(), Chess::Side(Chess::Side::White));
+	QCOMPARE(restored.legalMoves().size(), 19 * 19 - 7);
+	QVERIFY(restored.result().isNone());
+
+	// Play on from the restored position
+	Chess::Move move = restored.moveFromString("10,12");
+	restored.makeMove(move);
+	m_board->makeMove(move);
+	QCOMPARE(restored.key(), m_board->key());
+	move = restored.moveFromString("9,13");
+	restored.makeMove(move);
+	QVERIFY(restored.result().winner() == Chess::Side::Black);
+
+	// A won position is recognized without the move history
+	m_board->makeMove(move);
+	Chess::GomokuBoard won;
+	won.setPosition(board->position());
+	QVERIFY(won.result().winner() == Chess::Side::Black);
+
+	// Rows that are split into several line words
+	board->setWidth(100);
+	board->setHeight(40);
+	playMoves("0,0 99,39 31,5 32,5 63,20 64,20 99,0 0,39");
+	const QString bigFen = m_board->fenString();
+	Chess::GomokuBoard big;
+	big.setPosition(board->position());
+	QCOMPARE(big.width(), 100);
+	QCOMPARE(big.height(), 40);
+	QCOMPARE(big.fenString(), bigFen);
+	QCOMPARE(big.key(), m_board->key());
+	QCOMPARE(big.legalMoves().size(), 100 * 40 - 8);
+
+	m_board->setSize(15);
+}
+
+void tst_GomokuBoard::canonicalKeys_data() const
+{
+	QTest::addColumn<QString>("moves");
+	QTest::addColumn<QString>("symmetricMoves");
+
+	QTest::newRow("mirror files")
+		<< "0,0 1,3 2,5"
+		<< "14,0 13,3 12,5";
+	QTest::newRow("mirror ranks")
+		<< "0,0 1,3 2,5"
+		<< "0,14 1,11 2,9";
+	QTest::newRow("rotate 180")
+		<< "0,0 1,3 2,5"
+		<< "14,14 13,11 12,9";
+	QTest::newRow("transpose")
+		<< "0,0 1,3 2,5"
+		<< "0,0 3,1 5,2";
+	QTest::newRow("rotate 90")
+		<< "0,0 1,3 2,5"
+		<< "14,0 11,1 9,2";
+}
+
+void tst_GomokuBoard::canonicalKeys()
+{
+	QFETCH(QString, moves);
+	QFETCH(QString, symmetricMoves);
+
+	setVariant("gomoku");
+	auto board = dynamic_cast<Chess::GomokuBoard*>(m_board);
+	QVERIFY(board != 0);
+
+	playMoves(moves);
+	quint64 key = board->key();
+	quint64 canonicalKey = board->canonicalKey();
+
+	m_board->reset();
+	playMoves(symmetricMoves);
+	QVERIFY(board->key() != key);
+	QCOMPARE(board->canonicalKey(), canonicalKey);
+}
+
+QTEST_MAIN(tst_GomokuBoard)
+#include "tst_gomokuboard.moc"
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_playerpool
+SOURCES += tst_playerpool.cpp
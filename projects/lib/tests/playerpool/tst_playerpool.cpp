@@ -0,0 +1,75 @@
+#include <QtTest/QtTest>
+#include <playerpool.h>
+#include <humanbuilder.h>
+#include <humanplayer.h>
+
+class tst_PlayerPool: public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void take();
+		void capacity();
+		void clear();
+};
+
+void tst_PlayerPool::take()
+{
+	HumanBuilder builders[2];
+	PlayerPool pool;
+
+	auto player = new HumanPlayer;
+	pool.add(&builders[0], player);
+	QCOMPARE(pool.count(), 1);
+	QVERIFY(pool.take(&builders[1]) == nullptr);
+
+	ChessPlayer* taken = pool.take(&builders[0]);
+	QCOMPARE(taken, static_cast<ChessPlayer*>(player));
+	QVERIFY(taken->parent() == nullptr);
+	QVERIFY(pool.isEmpty());
+	delete taken;
+}
+
+void tst_PlayerPool::capacity()
+{
+	HumanBuilder builders[4];
+	PlayerPool pool;
+	QCOMPARE(pool.capacity(), 0);
+
+	pool.setCapacity(2);
+	for (int i = 0; i < 3; i++)
+		pool.add(&builders[i], new HumanPlayer);
+
+	// The oldest player is terminated
+	QCOMPARE(pool.count(), 2);
+	QVERIFY(pool.take(&builders[0]) == nullptr);
+
+	pool.add(&builders[3], new HumanPlayer);
+	pool.setCapacity(1);
+	QCOMPARE(pool.count(), 1);
+	QVERIFY(pool.take(&builders[1]) == nullptr);
+	QVERIFY(pool.take(&builders[2]) == nullptr);
+
+	ChessPlayer* player = pool.take(&builders[3]);
+	QVERIFY(player != nullptr);
+	delete player;
+}
+
+void tst_PlayerPool::clear()
+{
+	HumanBuilder builders[2];
+	PlayerPool pool;
+	QSignalSpy spy(&pool, SIGNAL(cleared()));
+
+	pool.setCapacity(1);
+	pool.add(&builders[0], new HumanPlayer);
+	pool.add(&builders[1], new HumanPlayer);
+	QCOMPARE(spy.count(), 0);
+
+	pool.clear();
+	QCOMPARE(spy.count(), 1);
+	QVERIFY(pool.isEmpty());
+}
+
+QTEST_MAIN(tst_PlayerPool)
+#include "tst_playerpool.moc"
@@ -1,5 +1,5 @@
 TEMPLATE = subdirs
-SUBDIRS = chessboard tb sprt mersenne tournamentplayer tournamentpair polyglotbook
+SUBDIRS = chessboard gomokuboard gomocupreply gomocupevalparser tb sprt mersenne tournamentplayer tournamentpair polyglotbook cpuaffinity concurrencycontroller gamemanager playerpool
 win32 {
     SUBDIRS += pipereader
 }